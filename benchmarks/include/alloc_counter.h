@@ -0,0 +1,13 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstddef>
+
+namespace bench {
+
+// Number of global operator new calls made by the benchmark process so far.
+std::size_t allocation_count();
+
+}  // namespace bench
+
+#endif  // !ALLOC_COUNTER_H
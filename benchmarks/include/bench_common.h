@@ -0,0 +1,48 @@
+#ifndef BENCH_COMMON_H
+#define BENCH_COMMON_H
+
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "synthetic_graph.h"
+
+namespace bench {
+
+inline constexpr std::array<std::size_t, 6> graph_sizes{50, 200, 1000, 5000, 20000, 100000};
+
+inline constexpr std::array<synthetic::topology, 3> topologies{
+    synthetic::topology::planar, synthetic::topology::near_planar,
+    synthetic::topology::random_geometric};
+
+template <std::size_t MaxNodes>
+void sizes_up_to(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"topology", "nodes"});
+
+    for (auto t : topologies) {
+        for (std::size_t n : graph_sizes) {
+            if (n <= MaxNodes) {
+                b->Args({static_cast<long>(t), static_cast<long>(n)});
+            }
+        }
+    }
+
+    b->Unit(benchmark::kMillisecond);
+}
+
+const synthetic::graph& graph_for(benchmark::State& state);
+
+std::vector<ogdf::node> to_ogdf(const synthetic::graph& g, ogdf::Graph& graph);
+
+void place_at_coordinates(const synthetic::graph& g, const std::vector<ogdf::node>& nodes,
+                          ogdf::GraphAttributes& graph_attribute);
+
+void set_graph_counters(benchmark::State& state, const synthetic::graph& g);
+
+}  // namespace bench
+
+#endif  // !BENCH_COMMON_H
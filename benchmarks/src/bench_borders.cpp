@@ -0,0 +1,45 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+#include "border_adjacency.h"
+#include "synthetic_graph.h"
+
+namespace {
+
+void cell_counts(benchmark::internal::Benchmark* b) {
+    b->ArgName("cells");
+
+    for (long n : {1000, 5000, 20000, 100000}) {
+        b->Arg(n);
+    }
+
+    b->Unit(benchmark::kMillisecond);
+}
+
+void run(benchmark::State& state, bool shared) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto cells = synthetic::lattice_boundaries(count, shared);
+
+    std::size_t borders = 0;
+
+    for (auto _ : state) {
+        auto shared_borders = spatial::find_shared_borders(cells);
+        benchmark::DoNotOptimize(shared_borders.data());
+        borders = shared_borders.size();
+    }
+
+    state.counters["borders"] = static_cast<double>(borders);
+}
+
+}  // namespace
+
+static void BM_shared_borders_exact(benchmark::State& state) {
+    run(state, true);
+}
+BENCHMARK(BM_shared_borders_exact)->Apply(cell_counts);
+
+static void BM_shared_borders_tolerance(benchmark::State& state) {
+    run(state, false);
+}
+BENCHMARK(BM_shared_borders_tolerance)->Apply(cell_counts);
@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+
+#include "bench_common.h"
+#include "centrality.h"
+#include "country_store.h"
+#include "synthetic_graph.h"
+
+static void BM_centrality_exact(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        auto scores = compute_centrality(graph);
+        benchmark::DoNotOptimize(scores.betweenness.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_centrality_exact)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_centrality_sampled(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        auto scores = compute_centrality(graph, {.samples = 256});
+        benchmark::DoNotOptimize(scores.betweenness.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_centrality_sampled)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_centrality_capital_distance(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const country_store store = synthetic::to_store(g);
+
+    for (auto _ : state) {
+        auto scores = compute_centrality(store, centrality_weight::capital_distance);
+        benchmark::DoNotOptimize(scores.betweenness.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_centrality_capital_distance)->Apply(bench::sizes_up_to<5000>);
+
+// Exact hop centrality on the 5000-node near-planar graph, by thread count.
+static void BM_centrality_threads(benchmark::State& state) {
+    const auto g = synthetic::generate(synthetic::topology::near_planar, 5000);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    const auto threads = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto scores = compute_centrality(graph, {.threads = threads});
+        benchmark::DoNotOptimize(scores.betweenness.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_centrality_threads)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,60 @@
+#include "bench_common.h"
+
+#include <map>
+#include <utility>
+
+namespace bench {
+
+const synthetic::graph& graph_for(benchmark::State& state) {
+    static std::map<std::pair<long, long>, synthetic::graph> cache;
+
+    const auto key = std::make_pair(state.range(0), state.range(1));
+    auto it = cache.find(key);
+
+    if (it == cache.end()) {
+        it = cache
+                 .emplace(key, synthetic::generate(
+                                   static_cast<synthetic::topology>(state.range(0)),
+                                   static_cast<std::size_t>(state.range(1))))
+                 .first;
+    }
+
+    state.SetLabel(synthetic::to_string(static_cast<synthetic::topology>(state.range(0))));
+
+    return it->second;
+}
+
+std::vector<ogdf::node> to_ogdf(const synthetic::graph& g, ogdf::Graph& graph) {
+    std::vector<ogdf::node> nodes;
+    nodes.reserve(g.coords.size());
+
+    for (std::size_t i = 0; i < g.coords.size(); i++) {
+        nodes.push_back(graph.newNode());
+    }
+
+    for (const auto& [u, v] : g.edges) {
+        graph.newEdge(nodes[u], nodes[v]);
+    }
+
+    return nodes;
+}
+
+void place_at_coordinates(const synthetic::graph& g, const std::vector<ogdf::node>& nodes,
+                          ogdf::GraphAttributes& graph_attribute) {
+    constexpr double scale = 400.0;
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        graph_attribute.x(nodes[i]) = g.coords[i].longitude * scale;
+        graph_attribute.y(nodes[i]) = -g.coords[i].latitude * scale;
+        graph_attribute.width(nodes[i]) = 120.0;
+        graph_attribute.height(nodes[i]) = 80.0;
+    }
+}
+
+void set_graph_counters(benchmark::State& state, const synthetic::graph& g) {
+    state.counters["nodes"] = static_cast<double>(g.coords.size());
+    state.counters["edges"] = static_cast<double>(g.edges.size());
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(g.coords.size()));
+}
+
+}  // namespace bench
@@ -0,0 +1,48 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include "bench_common.h"
+#include "synthetic_graph.h"
+#include "visual.h"
+
+static void BM_build_graph(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto countries = synthetic::to_store(g);
+
+    for (auto _ : state) {
+        ogdf::Graph graph;
+        ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+
+        build_graph(countries, graph, graph_attribute);
+
+        benchmark::DoNotOptimize(graph.numberOfEdges());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_build_graph)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_to_countries(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        auto countries = synthetic::to_countries(g);
+        benchmark::DoNotOptimize(countries.size());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_to_countries)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_to_store(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        auto countries = synthetic::to_store(g);
+        benchmark::DoNotOptimize(countries.size());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_to_store)->Apply(bench::sizes_up_to<100000>);
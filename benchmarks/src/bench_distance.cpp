@@ -0,0 +1,24 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_common.h"
+#include "distance_math.h"
+#include "synthetic_graph.h"
+
+static void BM_capital_distance(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        long double total = 0;
+
+        for (const auto& [u, v] : g.edges) {
+            total += distance(g.coords[u].latitude, g.coords[u].longitude,
+                              g.coords[v].latitude, g.coords[v].longitude);
+        }
+
+        benchmark::DoNotOptimize(total);
+    }
+
+    bench::set_graph_counters(state, g);
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(g.edges.size()));
+}
+BENCHMARK(BM_capital_distance)->Apply(bench::sizes_up_to<100000>);
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <nlohmann/json.hpp>
+#include <string>
+
+#include "fetch.h"
+#include "replay_server.h"
+
+namespace {
+
+enum class profile {
+    clean,
+    latency,
+    throttled,
+    server_errors,
+    slow_body,
+};
+
+const char* to_string(profile p) {
+    switch (p) {
+        case profile::clean:
+            return "clean";
+        case profile::latency:
+            return "latency";
+        case profile::throttled:
+            return "throttled";
+        case profile::server_errors:
+            return "server_errors";
+        case profile::slow_body:
+            return "slow_body";
+    }
+
+    return "unknown";
+}
+
+replay::fault_profile faults_for(profile p) {
+    using namespace std::chrono_literals;
+
+    switch (p) {
+        case profile::clean:
+            return {};
+        case profile::latency:
+            return {.latency = 20ms, .jitter = 10ms};
+        case profile::throttled:
+            return {.latency = 5ms, .throttle_rate = 0.05, .retry_after = 1s};
+        case profile::server_errors:
+            return {.latency = 5ms, .server_error_rate = 0.1};
+        case profile::slow_body:
+            return {.slow_body_chunk = 256, .slow_body_delay = 2ms};
+    }
+
+    return {};
+}
+
+// Separate servers stand in for the two hosts so the scheduler keeps a rate
+// limiter per host, as it does against the real APIs.
+replay::server& region_server(std::size_t host) {
+    static std::array<replay::server, 2> servers = [] {
+        std::ifstream file(REGION_FIXTURE_PATH);
+        const auto fixtures =
+            replay::fixtures_from_region_cache(nlohmann::json::parse(file), "europe");
+        return std::array<replay::server, 2>{replay::server(fixtures),
+                                             replay::server(fixtures)};
+    }();
+
+    return servers[host];
+}
+
+}  // namespace
+
+static void BM_fetch_region(benchmark::State& state) {
+    const auto p = static_cast<profile>(state.range(0));
+    auto& restcountries_server = region_server(0);
+    auto& geodatasource_server = region_server(1);
+
+    for (auto* server : {&restcountries_server, &geodatasource_server}) {
+        server->set_faults(faults_for(p));
+        server->reset_statistics();
+    }
+
+    const fetch::endpoints urls{.restcountries = restcountries_server.base_url(),
+                                .geodatasource = geodatasource_server.base_url()};
+
+    fetch::request_scheduler scheduler(
+        8, {.max_attempts = 6,
+            .base_delay = std::chrono::milliseconds(10),
+            .max_delay = std::chrono::milliseconds(500)});
+
+    fetch::configure_rate_limits(
+        scheduler, urls,
+        {.restcountries = {.requests_per_second = 500.0, .burst = 50.0, .quota = 0},
+         .geodatasource = {.requests_per_second = 250.0, .burst = 25.0, .quota = 0}});
+
+    std::size_t fetched = 0;
+    std::size_t expected = 0;
+
+    for (auto _ : state) {
+        auto codes = fetch::fetch_region_codes(scheduler, "europe", urls);
+
+        if (!codes) {
+            state.SkipWithError(codes.error().message.c_str());
+            break;
+        }
+
+        auto countries = fetch::fetch_countries(scheduler, "replay", codes.value(), urls);
+
+        if (countries) {
+            fetched += countries.value().size();
+        }
+
+        expected += codes.value().size();
+    }
+
+    const auto a = restcountries_server.statistics();
+    const auto b = geodatasource_server.statistics();
+    const auto restcountries = scheduler.usage(urls.restcountries);
+    const auto geodatasource = scheduler.usage(urls.geodatasource);
+
+    state.SetLabel(to_string(p));
+    state.counters["requests"] = static_cast<double>(a.requests + b.requests);
+    state.counters["throttled"] = static_cast<double>(a.throttled + b.throttled);
+    state.counters["server_errors"] = static_cast<double>(a.server_errors + b.server_errors);
+    state.counters["retries"] =
+        static_cast<double>(restcountries.retries + geodatasource.retries);
+    state.counters["completeness"] =
+        expected == 0 ? 0.0 : static_cast<double>(fetched) / static_cast<double>(expected);
+}
+BENCHMARK(BM_fetch_region)
+    ->ArgName("profile")
+    ->DenseRange(0, static_cast<long>(profile::slow_body))
+    ->Iterations(2)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
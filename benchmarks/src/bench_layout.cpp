@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "layout_cache.h"
+#include "synthetic_graph.h"
+#include "visual.h"
+
+static void BM_layout_graph(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    const auto nodes = bench::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        bench::place_at_coordinates(g, nodes, graph_attribute);
+        state.ResumeTiming();
+
+        layout_graph(graph_attribute);
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_layout_graph)->Apply(bench::sizes_up_to<1000>);
+
+static std::string layout_cache_path(benchmark::State& state) {
+    return (std::filesystem::temp_directory_path() /
+            ("bench_layout_" + std::to_string(state.range(0)) + "_" +
+             std::to_string(state.range(1)) + ".json"))
+        .string();
+}
+
+static ogdf::NodeArray<std::string> node_keys(const ogdf::Graph& graph,
+                                              const std::vector<ogdf::node>& nodes) {
+    ogdf::NodeArray<std::string> keys(graph);
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        keys[nodes[i]] = synthetic::node_key(static_cast<std::uint32_t>(i));
+    }
+
+    return keys;
+}
+
+// Unchanged graph: the cached layout is copied and the layout step is skipped.
+static void BM_layout_cache_reuse(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    const auto nodes = bench::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+    const auto keys = node_keys(graph, nodes);
+
+    const std::string path = layout_cache_path(state);
+    std::filesystem::remove(path);
+    layout_cache::layout(graph_attribute, keys, path);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(layout_cache::layout(graph_attribute, keys, path));
+    }
+
+    std::filesystem::remove(path);
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_layout_cache_reuse)->Apply(bench::sizes_up_to<1000>);
+
+// One border removed since the cached layout: refined from the old positions.
+static void BM_layout_cache_warm_start(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    const auto nodes = bench::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+
+    const std::string path = layout_cache_path(state);
+    const std::string original = path + ".original";
+
+    std::filesystem::remove(original);
+    layout_cache::layout(graph_attribute, node_keys(graph, nodes), original);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::filesystem::copy_file(original, path,
+                                   std::filesystem::copy_options::overwrite_existing);
+
+        ogdf::Graph changed;
+        const auto changed_nodes = bench::to_ogdf(g, changed);
+        ogdf::GraphAttributes changed_attribute(changed, graph_attribute_flags);
+        const auto changed_keys = node_keys(changed, changed_nodes);
+        changed.delEdge(*changed.edges.begin());
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(layout_cache::layout(changed_attribute, changed_keys, path));
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(original);
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_layout_cache_warm_start)->Apply(bench::sizes_up_to<1000>);
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <unordered_map>
+
+#include "alloc_counter.h"
+#include "bench_common.h"
+#include "country.h"
+#include "json_file.h"
+#include "region_data.h"
+#include "synthetic_graph.h"
+
+namespace {
+
+std::string region_file_for(benchmark::State& state) {
+    const auto filename = std::filesystem::temp_directory_path() /
+                          ("region_graph_benchmark_" + std::to_string(state.range(0)) + "_" +
+                           std::to_string(state.range(1)) + ".json");
+
+    if (!std::filesystem::exists(filename)) {
+        nlohmann::json j(synthetic::to_countries(bench::graph_for(state)));
+        json_file::write(filename.string(), j);
+    }
+
+    return filename.string();
+}
+
+void set_allocation_counters(benchmark::State& state, std::size_t allocations,
+                             std::size_t countries) {
+    state.counters["allocs_per_country"] =
+        static_cast<double>(allocations) /
+        static_cast<double>(state.iterations() * countries);
+}
+
+}  // namespace
+
+static void BM_load_json_dom(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto filename = region_file_for(state);
+
+    const std::size_t allocations_before = bench::allocation_count();
+
+    for (auto _ : state) {
+        auto region = json_file::read(filename);
+        auto countries = region->get<std::unordered_map<std::string, country>>();
+        benchmark::DoNotOptimize(countries.size());
+    }
+
+    set_allocation_counters(state, bench::allocation_count() - allocations_before,
+                            g.coords.size());
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_load_json_dom)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_load_country_store(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto filename = region_file_for(state);
+
+    const std::size_t allocations_before = bench::allocation_count();
+
+    for (auto _ : state) {
+        auto countries = json_file::read_countries(filename);
+        benchmark::DoNotOptimize(countries->size());
+    }
+
+    set_allocation_counters(state, bench::allocation_count() - allocations_before,
+                            g.coords.size());
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_load_country_store)->Apply(bench::sizes_up_to<100000>);
+
+// The checked-in europe.json, read from disk as on a launch without embedded data.
+static void BM_load_region_file(benchmark::State& state) {
+    for (auto _ : state) {
+        auto countries = json_file::read_countries(REGION_FIXTURE_PATH);
+        benchmark::DoNotOptimize(countries->size());
+    }
+}
+BENCHMARK(BM_load_region_file)->Unit(benchmark::kMicrosecond);
+
+// The same region from the tables compiled into region_data.
+static void BM_load_region_embedded(benchmark::State& state) {
+    const region_data::region* embedded = region_data::find("europe");
+
+    if (embedded == nullptr) {
+        state.SkipWithError("europe is not embedded");
+        return;
+    }
+
+    for (auto _ : state) {
+        auto countries = region_data::to_store(*embedded);
+        benchmark::DoNotOptimize(countries.size());
+    }
+}
+BENCHMARK(BM_load_region_embedded)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,241 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/simple_graph_alg.h>
+
+#include "adjacency_matrix.h"
+#include "bench_common.h"
+#include "dynamic_metrics.h"
+#include "metrics.h"
+#include "synthetic_graph.h"
+
+static void BM_connected_components(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        ogdf::NodeArray<int> component_map(graph);
+        benchmark::DoNotOptimize(ogdf::connectedComponents(graph, component_map));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_connected_components)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_extract_component(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    ogdf::NodeArray<int> component_map(graph);
+    ogdf::connectedComponents(graph, component_map);
+
+    for (auto _ : state) {
+        ogdf::Graph component;
+        extract_component(component, graph, component_map, 0);
+        benchmark::DoNotOptimize(component.numberOfNodes());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_extract_component)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_calculate_diameter(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculate_diameter(graph));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_calculate_diameter)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_find_graph_centers(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        auto centers = find_graph_centers(graph);
+        benchmark::DoNotOptimize(centers.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_find_graph_centers)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_find_max_clique(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(find_max_clique(graph));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_find_max_clique)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_calculate_metrics(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph);
+
+    for (auto _ : state) {
+        metrics* m = calculate_metrics(graph, graph_attribute);
+        benchmark::DoNotOptimize(m);
+        delete_metrics(m);
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_calculate_metrics)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_calculate_metrics_approximate(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph);
+
+    for (auto _ : state) {
+        metrics* m = calculate_metrics(graph, graph_attribute, metrics_engine::approximate);
+        benchmark::DoNotOptimize(m);
+        delete_metrics(m);
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_calculate_metrics_approximate)->Apply(bench::sizes_up_to<20000>);
+
+static void BM_dynamic_metrics_build(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        dynamic_metrics dynamic(g.coords.size(), g.edges);
+        benchmark::DoNotOptimize(dynamic.current().biggest_component_diameter);
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_dynamic_metrics_build)->Apply(bench::sizes_up_to<5000>);
+
+// One border closed and reopened per iteration, cycling through every border.
+static void BM_dynamic_border_toggle(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    dynamic_metrics dynamic(g.coords.size(), g.edges);
+
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        const auto [u, v] = g.edges[next++ % g.edges.size()];
+
+        const dynamic_metrics::change close{
+            .type = dynamic_metrics::change::kind::delete_edge, .u = u, .v = v};
+        const dynamic_metrics::change reopen{
+            .type = dynamic_metrics::change::kind::insert_edge, .u = u, .v = v};
+
+        benchmark::DoNotOptimize(dynamic.apply({&close, 1}));
+        benchmark::DoNotOptimize(dynamic.apply({&reopen, 1}));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_dynamic_border_toggle)->Apply(bench::sizes_up_to<5000>);
+
+static adjacency_matrix matrix_for(const synthetic::graph& g) {
+    adjacency_matrix matrix(g.coords.size());
+
+    for (const auto& [u, v] : g.edges) {
+        matrix.add_edge(u, v);
+    }
+
+    return matrix;
+}
+
+static void BM_adjacency_matrix_build(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        auto matrix = matrix_for(g);
+        benchmark::DoNotOptimize(matrix.row(0).data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_adjacency_matrix_build)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_common_neighbours(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto matrix = matrix_for(g);
+
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        const auto [u, v] = g.edges[next++ % g.edges.size()];
+        benchmark::DoNotOptimize(matrix.common_neighbours(u, v));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_common_neighbours)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_count_triangles(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto matrix = matrix_for(g);
+
+    std::size_t triangles = 0;
+
+    for (auto _ : state) {
+        triangles = count_triangles(matrix);
+        benchmark::DoNotOptimize(triangles);
+    }
+
+    state.counters["triangles"] = static_cast<double>(triangles);
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_count_triangles)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_clustering(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto matrix = matrix_for(g);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(global_clustering(matrix));
+        benchmark::DoNotOptimize(average_clustering(matrix));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_clustering)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_core_numbers(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto matrix = matrix_for(g);
+
+    for (auto _ : state) {
+        auto cores = core_numbers(matrix);
+        benchmark::DoNotOptimize(cores.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_core_numbers)->Apply(bench::sizes_up_to<5000>);
+
+static void BM_dsatur_coloring(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto matrix = matrix_for(g);
+
+    for (auto _ : state) {
+        auto colors = dsatur_coloring(matrix);
+        benchmark::DoNotOptimize(colors.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_dsatur_coloring)->Apply(bench::sizes_up_to<5000>);
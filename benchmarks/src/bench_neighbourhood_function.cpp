@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+
+#include "bench_common.h"
+#include "neighbourhood_function.h"
+#include "synthetic_graph.h"
+
+static void BM_hyperanf(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    neighbourhood_function nf;
+
+    for (auto _ : state) {
+        nf = approximate_neighbourhood_function(graph);
+        benchmark::DoNotOptimize(nf.pairs.data());
+    }
+
+    state.counters["iterations"] = static_cast<double>(nf.pairs.size() - 1);
+    state.counters["avg_distance"] = average_distance(nf).value;
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_hyperanf)->Apply(bench::sizes_up_to<100000>);
+
+// Counter size against accuracy on the 20000-node near-planar graph.
+static void BM_hyperanf_registers(benchmark::State& state) {
+    const auto g = synthetic::generate(synthetic::topology::near_planar, 20000);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    const auto log2_registers = static_cast<unsigned>(state.range(0));
+    neighbourhood_function nf;
+
+    for (auto _ : state) {
+        nf = approximate_neighbourhood_function(graph, {.log2_registers = log2_registers});
+        benchmark::DoNotOptimize(nf.pairs.data());
+    }
+
+    const interval_estimate distance = average_distance(nf);
+
+    state.counters["rse"] = nf.relative_standard_error;
+    state.counters["avg_distance"] = distance.value;
+    state.counters["avg_distance_width"] = distance.high - distance.low;
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_hyperanf_registers)
+    ->ArgName("log2_registers")
+    ->DenseRange(4, 10, 2)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_hyperanf_threads(benchmark::State& state) {
+    const auto g = synthetic::generate(synthetic::topology::near_planar, 100000);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    const auto threads = static_cast<std::size_t>(state.range(0));
+
+    for (auto _ : state) {
+        auto nf = approximate_neighbourhood_function(graph, {.threads = threads});
+        benchmark::DoNotOptimize(nf.pairs.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_hyperanf_threads)
+    ->ArgName("threads")
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "capital_index.h"
+#include "country.h"
+#include "synthetic_graph.h"
+
+namespace {
+
+constexpr std::size_t k_nearest = 8;
+constexpr double radius_km = 250.0;
+
+std::vector<capital_coordinates> query_points(const synthetic::graph& g, std::size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, g.coords.size() - 1);
+    std::normal_distribution<double> jitter(0.0, 0.5);
+
+    std::vector<capital_coordinates> points;
+    points.reserve(count);
+
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& c = g.coords[pick(rng)];
+        points.push_back(
+            {.latitude = c.latitude + jitter(rng), .longitude = c.longitude + jitter(rng)});
+    }
+
+    return points;
+}
+
+}  // namespace
+
+static void BM_capital_index_build(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+
+    for (auto _ : state) {
+        spatial::capital_index index(g.coords);
+        benchmark::DoNotOptimize(index.size());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_capital_index_build)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_nearest_capitals(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const spatial::capital_index index(g.coords);
+    const auto queries = query_points(g, 1024);
+
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.nearest(queries[next++ % queries.size()], k_nearest));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_nearest_capitals)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_nearest_capitals_brute_force(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const auto queries = query_points(g, 1024);
+
+    std::size_t next = 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            spatial::brute_force_nearest(g.coords, queries[next++ % queries.size()], k_nearest));
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_nearest_capitals_brute_force)->Apply(bench::sizes_up_to<20000>);
+
+static void BM_capitals_within(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const spatial::capital_index index(g.coords);
+    const auto queries = query_points(g, 1024);
+
+    std::size_t next = 0;
+    std::size_t found = 0;
+
+    for (auto _ : state) {
+        const auto matches = index.within(queries[next++ % queries.size()], radius_km);
+        found += matches.size();
+        benchmark::DoNotOptimize(matches.data());
+    }
+
+    state.counters["matches"] =
+        benchmark::Counter(static_cast<double>(found), benchmark::Counter::kAvgIterations);
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_capitals_within)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_nearest_capitals_batch(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const spatial::capital_index index(g.coords);
+    const auto queries = query_points(g, 1024);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.nearest(queries, k_nearest));
+    }
+
+    state.counters["queries"] = static_cast<double>(queries.size());
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_nearest_capitals_batch)->Apply(bench::sizes_up_to<100000>);
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/fileformats/GraphIO.h>
+
+#include <filesystem>
+#include <limits>
+#include <string>
+
+#include "bench_common.h"
+#include "svg_writer.h"
+#include "synthetic_graph.h"
+#include "visual.h"
+
+namespace {
+
+struct labelled_drawing {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes graph_attribute{graph, graph_attribute_flags};
+
+    explicit labelled_drawing(const synthetic::graph& g) {
+        const auto nodes = bench::to_ogdf(g, graph);
+
+        bench::place_at_coordinates(g, nodes, graph_attribute);
+
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            graph_attribute.label(nodes[i]) = synthetic::node_key(i);
+        }
+
+        for (ogdf::edge e : graph.edges) {
+            graph_attribute.strokeWidth(e) = 2.0;
+            graph_attribute.label(e) = std::to_string(e->index());
+        }
+    }
+};
+
+std::string temp_file(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void report_file(benchmark::State& state, const std::string& filename,
+                 const synthetic::graph& g) {
+    state.counters["bytes"] = static_cast<double>(std::filesystem::file_size(filename));
+    std::filesystem::remove(filename);
+
+    bench::set_graph_counters(state, g);
+}
+
+constexpr svg::options full_detail{.edge_label_limit = std::numeric_limits<std::size_t>::max(),
+                                   .merge_node_limit = std::numeric_limits<std::size_t>::max()};
+
+}  // namespace
+
+static void BM_write_svg_graphio(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const labelled_drawing drawing(g);
+    const std::string filename = temp_file("region_graph_benchmark_graphio.svg");
+
+    for (auto _ : state) {
+        ogdf::GraphIO::write(drawing.graph_attribute, filename, ogdf::GraphIO::drawSVG);
+    }
+
+    report_file(state, filename, g);
+}
+BENCHMARK(BM_write_svg_graphio)->Apply(bench::sizes_up_to<20000>);
+
+static void BM_write_graph_svg(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const labelled_drawing drawing(g);
+    const std::string filename = temp_file("region_graph_benchmark.svg");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write_graph_svg(drawing.graph_attribute, filename, full_detail));
+    }
+
+    report_file(state, filename, g);
+}
+BENCHMARK(BM_write_graph_svg)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_write_graph_svgz(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const labelled_drawing drawing(g);
+    const std::string filename = temp_file("region_graph_benchmark.svgz");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write_graph_svg(drawing.graph_attribute, filename, full_detail));
+    }
+
+    report_file(state, filename, g);
+}
+BENCHMARK(BM_write_graph_svgz)->Apply(bench::sizes_up_to<100000>);
+
+static void BM_write_graph_svg_level_of_detail(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    const labelled_drawing drawing(g);
+    const std::string filename = temp_file("region_graph_benchmark_lod.svg");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(write_graph_svg(drawing.graph_attribute, filename));
+    }
+
+    report_file(state, filename, g);
+}
+BENCHMARK(BM_write_graph_svg_level_of_detail)->Apply(bench::sizes_up_to<100000>);
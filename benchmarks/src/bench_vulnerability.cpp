@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/simple_graph_alg.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bench_common.h"
+#include "synthetic_graph.h"
+#include "vulnerability.h"
+
+static void BM_vulnerability_analysis(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    bench::to_ogdf(g, graph);
+
+    for (auto _ : state) {
+        auto report = analyse_vulnerability(graph);
+        benchmark::DoNotOptimize(report.country_removal.data());
+    }
+
+    const auto report = analyse_vulnerability(graph);
+    state.counters["articulation"] = static_cast<double>(report.articulation_countries.size());
+    state.counters["bridges"] = static_cast<double>(report.bridge_borders.size());
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_vulnerability_analysis)->Apply(bench::sizes_up_to<100000>);
+
+// Baseline: one connectedComponents run per removed country.
+static void BM_vulnerability_rerun(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    const auto nodes = bench::to_ogdf(g, graph);
+
+    std::vector<int> components(nodes.size());
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            ogdf::Graph without(graph);
+
+            for (ogdf::node v : without.nodes) {
+                if (v->index() == nodes[i]->index()) {
+                    without.delNode(v);
+                    break;
+                }
+            }
+
+            ogdf::NodeArray<int> component_map(without);
+            components[i] = ogdf::connectedComponents(without, component_map);
+        }
+
+        benchmark::DoNotOptimize(components.data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_vulnerability_rerun)->Apply(bench::sizes_up_to<1000>);
+
+// Every country removed one after another in a fixed random order.
+static void BM_removal_sequence(benchmark::State& state) {
+    const auto& g = bench::graph_for(state);
+    ogdf::Graph graph;
+    const auto nodes = bench::to_ogdf(g, graph);
+
+    std::vector<removal> sequence;
+    sequence.reserve(nodes.size());
+
+    for (ogdf::node v : nodes) {
+        sequence.push_back({.type = removal::kind::country, .index = v->index()});
+    }
+
+    std::shuffle(sequence.begin(), sequence.end(), std::mt19937(42));
+
+    for (auto _ : state) {
+        auto effects = removal_sequence(graph, sequence);
+        benchmark::DoNotOptimize(effects->data());
+    }
+
+    bench::set_graph_counters(state, g);
+}
+BENCHMARK(BM_removal_sequence)->Apply(bench::sizes_up_to<100000>);
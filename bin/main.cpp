@@ -1,3 +1,4 @@
+#include <charconv>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
@@ -15,7 +16,33 @@ int main(void) {
         return EXIT_FAILURE;
     }
 
-    graph_builder builder(geo_data_api_key);
+    fetch::endpoints urls;
+
+    if (const char* restcountries_url = std::getenv("restcountries_url");
+        restcountries_url != nullptr && strlen(restcountries_url) != 0) {
+        urls.restcountries = restcountries_url;
+    }
+
+    if (const char* geodatasource_url = std::getenv("geodatasource_url");
+        geodatasource_url != nullptr && strlen(geodatasource_url) != 0) {
+        urls.geodatasource = geodatasource_url;
+    }
+
+    fetch::limits rate_limits;
+
+    if (const char* geo_data_quota = std::getenv("geo_data_quota");
+        geo_data_quota != nullptr && strlen(geo_data_quota) != 0) {
+        const char* end = geo_data_quota + strlen(geo_data_quota);
+        const auto [ptr, ec] =
+            std::from_chars(geo_data_quota, end, rate_limits.geodatasource.quota);
+
+        if (ec != std::errc{} || ptr != end) {
+            std::cerr << "error: geo data quota is not a valid request count" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    graph_builder builder(geo_data_api_key, urls, rate_limits);
 
     auto result = builder.build(region_to_search_in);
 
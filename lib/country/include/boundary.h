@@ -0,0 +1,21 @@
+#ifndef BOUNDARY_H
+#define BOUNDARY_H
+
+#include <string>
+#include <vector>
+
+// Degrees, in GeoJSON order.
+struct geo_point {
+    double longitude;
+    double latitude;
+};
+
+// A country or province outline: every ring of every polygon, outer rings and
+// holes alike. Rings may repeat their first point at the end.
+struct boundary {
+    std::string name;
+    std::string code;
+    std::vector<std::vector<geo_point>> rings;
+};
+
+#endif  // !BOUNDARY_H
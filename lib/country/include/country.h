@@ -2,6 +2,7 @@
 #define COUNTRY_H
 
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -16,11 +17,34 @@ struct country {
     std::string name;
     std::string iso_code;
     std::string capital;
-    struct capital_coordinates capital_coords;
+    // Unset when the source has no position for the capital; the json key is
+    // then left out.
+    std::optional<capital_coordinates> capital_coords;
     std::vector<std::string> neighboring_countries_iso;
-
-    NLOHMANN_DEFINE_TYPE_INTRUSIVE(country, name, iso_code, capital, capital_coords,
-                                   neighboring_countries_iso)
 };
 
+inline void to_json(nlohmann::json& j, const country& c) {
+    j = nlohmann::json{{"name", c.name},
+                       {"iso_code", c.iso_code},
+                       {"capital", c.capital},
+                       {"neighboring_countries_iso", c.neighboring_countries_iso}};
+
+    if (c.capital_coords) {
+        j["capital_coords"] = *c.capital_coords;
+    }
+}
+
+inline void from_json(const nlohmann::json& j, country& c) {
+    j.at("name").get_to(c.name);
+    j.at("iso_code").get_to(c.iso_code);
+    j.at("capital").get_to(c.capital);
+    j.at("neighboring_countries_iso").get_to(c.neighboring_countries_iso);
+
+    if (const auto it = j.find("capital_coords"); it != j.end()) {
+        c.capital_coords = it->get<capital_coordinates>();
+    } else {
+        c.capital_coords.reset();
+    }
+}
+
 #endif  // !COUNTRY_H
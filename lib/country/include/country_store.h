@@ -0,0 +1,114 @@
+#ifndef COUNTRY_STORE_H
+#define COUNTRY_STORE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "country.h"
+#include "iso_code.h"
+
+struct country_entry {
+    std::string_view name;
+    std::string_view code;
+    std::string_view capital;
+    std::optional<capital_coordinates> capital_coords;
+    iso_code iso;
+    std::uint32_t first_neighbour;
+    std::uint32_t neighbour_count;
+};
+
+// Countries of one region, with every string interned into a monotonic arena
+// owned by the store. Entries are views into that arena and stay valid for the
+// store's lifetime, including across moves. Containers are bound to the arena,
+// so the store can be move constructed but not move assigned.
+//
+// ISO alpha-2 codes resolve through a 676-slot table; any other code (admin
+// regions, synthetic data) falls back to an interned-string index. A code can
+// be added once; add() returns npos for a repeat and leaves the store as it
+// was. Neighbours are resolved into dense-index CSR arrays by link(), which
+// must be called after the last add() and before neighbours(). Border lengths
+// are optional and only stored once some country comes with them.
+class country_store {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFF;
+
+    explicit country_store(std::size_t initial_arena_bytes = 64 * 1024);
+
+    country_store(country_store&&) noexcept = default;
+    country_store& operator=(country_store&&) = delete;
+
+    country_store(const country_store&) = delete;
+    country_store& operator=(const country_store&) = delete;
+
+    void reserve(std::size_t countries, std::size_t neighbours);
+
+    // border_km is empty or holds the length of the border with each of
+    // neighbour_codes.
+    std::uint32_t add(std::string_view name, std::string_view code, std::string_view capital,
+                      std::optional<capital_coordinates> capital_coords,
+                      std::span<const std::string_view> neighbour_codes,
+                      std::span<const double> border_km = {});
+
+    std::uint32_t add(const country& c);
+
+    void link();
+
+    // Installs neighbours resolved ahead of time instead of calling link():
+    // offsets holds size() + 1 positions into targets, and each country's
+    // range lists the store indices link() would have produced for it. Border
+    // lengths are not carried over.
+    void adopt_links(std::span<const std::uint32_t> offsets,
+                     std::span<const std::uint32_t> targets);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    const country_entry& operator[](std::uint32_t index) const;
+    std::span<const country_entry> entries() const;
+
+    std::optional<std::uint32_t> find(iso_code iso) const;
+    std::optional<std::uint32_t> find(std::string_view code) const;
+
+    std::span<const std::uint32_t> neighbours(std::uint32_t index) const;
+
+    // Length in km of the border with each of neighbours(index), NaN where it
+    // is not known, or an empty span when no country was added with lengths.
+    std::span<const double> border_km(std::uint32_t index) const;
+
+    country to_country(std::uint32_t index) const;
+
+private:
+    std::string_view intern(std::string_view value);
+    std::uint32_t code_id(std::string_view code);
+    std::string_view code_name(std::uint32_t id) const;
+    std::uint32_t resolve(std::uint32_t id) const;
+
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena_;
+    std::pmr::unordered_set<std::string_view> strings_;
+    std::pmr::vector<country_entry> entries_;
+    std::pmr::vector<std::uint32_t> neighbour_codes_;
+    std::pmr::vector<double> neighbour_km_;
+
+    std::array<std::uint32_t, iso_code::count> iso_index_;
+    std::pmr::unordered_map<std::string_view, std::uint32_t> code_ids_;
+    std::pmr::vector<std::string_view> codes_;
+    std::pmr::vector<std::uint32_t> code_index_;
+
+    std::pmr::vector<std::uint32_t> neighbour_offsets_;
+    std::pmr::vector<std::uint32_t> neighbour_targets_;
+    std::pmr::vector<double> target_km_;
+    bool linked_{true};
+};
+
+void to_json(nlohmann::json& j, const country_store& store);
+
+#endif  // !COUNTRY_STORE_H
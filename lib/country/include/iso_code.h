@@ -0,0 +1,88 @@
+#ifndef ISO_CODE_H
+#define ISO_CODE_H
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+
+// ISO 3166-1 alpha-2 code packed into its dense index (AA = 0 ... ZZ = 675), so
+// a code doubles as a slot in a 676-entry lookup table.
+class iso_code {
+public:
+    static constexpr std::size_t count = 26 * 26;
+
+    constexpr iso_code() = default;
+
+    constexpr explicit iso_code(std::uint16_t index) : value_(index < count ? index : invalid) {}
+
+    static constexpr iso_code from_string(std::string_view code) {
+        if (code.size() != 2) {
+            return {};
+        }
+
+        const char first = upper(code[0]);
+        const char second = upper(code[1]);
+
+        if (first < 'A' || first > 'Z' || second < 'A' || second > 'Z') {
+            return {};
+        }
+
+        return iso_code(static_cast<std::uint16_t>((first - 'A') * 26 + (second - 'A')));
+    }
+
+    constexpr bool valid() const { return value_ != invalid; }
+
+    constexpr std::uint16_t index() const { return value_; }
+
+    std::string_view to_string_view() const;
+
+    std::string to_string() const { return std::string(to_string_view()); }
+
+    constexpr auto operator<=>(const iso_code&) const = default;
+
+private:
+    static constexpr std::uint16_t invalid = 0xFFFF;
+
+    static constexpr char upper(char c) {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    std::uint16_t value_{invalid};
+};
+
+inline constexpr auto iso_code_letters = [] {
+    std::array<char, iso_code::count * 2> letters{};
+
+    for (std::size_t i = 0; i < iso_code::count; i++) {
+        letters[i * 2] = static_cast<char>('A' + i / 26);
+        letters[i * 2 + 1] = static_cast<char>('A' + i % 26);
+    }
+
+    return letters;
+}();
+
+inline std::string_view iso_code::to_string_view() const {
+    if (!valid()) {
+        return {};
+    }
+
+    return std::string_view(iso_code_letters.data() + value_ * 2, 2);
+}
+
+template <>
+struct std::hash<iso_code> {
+    std::size_t operator()(iso_code code) const noexcept { return code.index(); }
+};
+
+inline void to_json(nlohmann::json& j, const iso_code& code) { j = code.to_string_view(); }
+
+inline void from_json(const nlohmann::json& j, iso_code& code) {
+    code = iso_code::from_string(j.get<std::string>());
+}
+
+#endif  // !ISO_CODE_H
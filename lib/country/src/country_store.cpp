@@ -0,0 +1,246 @@
+#include "country_store.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <string>
+
+country_store::country_store(std::size_t initial_arena_bytes)
+    : arena_(std::make_unique<std::pmr::monotonic_buffer_resource>(initial_arena_bytes)),
+      strings_(arena_.get()),
+      entries_(arena_.get()),
+      neighbour_codes_(arena_.get()),
+      neighbour_km_(arena_.get()),
+      code_ids_(arena_.get()),
+      codes_(arena_.get()),
+      code_index_(arena_.get()),
+      neighbour_offsets_(arena_.get()),
+      neighbour_targets_(arena_.get()),
+      target_km_(arena_.get()) {
+    iso_index_.fill(npos);
+}
+
+void country_store::reserve(std::size_t countries, std::size_t neighbours) {
+    entries_.reserve(countries);
+    neighbour_codes_.reserve(neighbours);
+    strings_.reserve(countries * 2);
+}
+
+std::string_view country_store::intern(std::string_view value) {
+    if (const auto it = strings_.find(value); it != strings_.end()) {
+        return *it;
+    }
+
+    auto* storage = static_cast<char*>(arena_->allocate(value.size(), alignof(char)));
+    std::memcpy(storage, value.data(), value.size());
+
+    return *strings_.emplace(storage, value.size()).first;
+}
+
+std::uint32_t country_store::code_id(std::string_view code) {
+    if (const auto iso = iso_code::from_string(code); iso.valid()) {
+        return iso.index();
+    }
+
+    const auto id = static_cast<std::uint32_t>(iso_code::count + codes_.size());
+    const auto [it, inserted] = code_ids_.try_emplace(intern(code), id);
+
+    if (inserted) {
+        codes_.push_back(it->first);
+        code_index_.push_back(npos);
+    }
+
+    return it->second;
+}
+
+std::string_view country_store::code_name(std::uint32_t id) const {
+    if (id < iso_code::count) {
+        return iso_code(static_cast<std::uint16_t>(id)).to_string_view();
+    }
+
+    return codes_[id - iso_code::count];
+}
+
+std::uint32_t country_store::resolve(std::uint32_t id) const {
+    return id < iso_code::count ? iso_index_[id] : code_index_[id - iso_code::count];
+}
+
+std::uint32_t country_store::add(std::string_view name, std::string_view code,
+                                 std::string_view capital,
+                                 std::optional<capital_coordinates> capital_coords,
+                                 std::span<const std::string_view> neighbour_codes,
+                                 std::span<const double> border_km) {
+    assert(border_km.empty() || border_km.size() == neighbour_codes.size());
+
+    const auto index = static_cast<std::uint32_t>(entries_.size());
+    const std::uint32_t id = code_id(code);
+
+    if (resolve(id) != npos) {
+        return npos;
+    }
+
+    entries_.push_back(country_entry{
+        .name = intern(name),
+        .code = code_name(id),
+        .capital = intern(capital),
+        .capital_coords = capital_coords,
+        .iso = iso_code::from_string(code),
+        .first_neighbour = static_cast<std::uint32_t>(neighbour_codes_.size()),
+        .neighbour_count = static_cast<std::uint32_t>(neighbour_codes.size())});
+
+    constexpr double unknown = std::numeric_limits<double>::quiet_NaN();
+
+    // Countries added before the first one with lengths get unknown lengths.
+    if (!border_km.empty() && neighbour_km_.empty()) {
+        neighbour_km_.assign(neighbour_codes_.size(), unknown);
+    }
+
+    for (const auto neighbour : neighbour_codes) {
+        neighbour_codes_.push_back(code_id(neighbour));
+    }
+
+    if (!border_km.empty()) {
+        neighbour_km_.insert(neighbour_km_.end(), border_km.begin(), border_km.end());
+    } else if (!neighbour_km_.empty()) {
+        neighbour_km_.resize(neighbour_codes_.size(), unknown);
+    }
+
+    if (id < iso_code::count) {
+        iso_index_[id] = index;
+    } else {
+        code_index_[id - iso_code::count] = index;
+    }
+
+    linked_ = false;
+
+    return index;
+}
+
+std::uint32_t country_store::add(const country& c) {
+    std::vector<std::string_view> neighbours(c.neighboring_countries_iso.begin(),
+                                             c.neighboring_countries_iso.end());
+
+    return add(c.name, c.iso_code, c.capital, c.capital_coords, neighbours);
+}
+
+void country_store::link() {
+    if (linked_) {
+        return;
+    }
+
+    neighbour_offsets_.assign(entries_.size() + 1, 0);
+    neighbour_targets_.clear();
+    neighbour_targets_.reserve(neighbour_codes_.size());
+    target_km_.clear();
+    target_km_.reserve(neighbour_km_.size());
+
+    for (std::size_t i = 0; i < entries_.size(); i++) {
+        const auto& entry = entries_[i];
+
+        for (std::uint32_t k = 0; k < entry.neighbour_count; k++) {
+            const std::uint32_t position = entry.first_neighbour + k;
+
+            if (const auto target = resolve(neighbour_codes_[position]); target != npos) {
+                neighbour_targets_.push_back(target);
+
+                if (!neighbour_km_.empty()) {
+                    target_km_.push_back(neighbour_km_[position]);
+                }
+            }
+        }
+
+        neighbour_offsets_[i + 1] = static_cast<std::uint32_t>(neighbour_targets_.size());
+    }
+
+    linked_ = true;
+}
+
+void country_store::adopt_links(std::span<const std::uint32_t> offsets,
+                                std::span<const std::uint32_t> targets) {
+    assert(offsets.size() == entries_.size() + 1 && offsets.front() == 0 &&
+           offsets.back() == targets.size());
+
+    neighbour_offsets_.assign(offsets.begin(), offsets.end());
+    neighbour_targets_.assign(targets.begin(), targets.end());
+    target_km_.clear();
+
+    linked_ = true;
+}
+
+std::size_t country_store::size() const { return entries_.size(); }
+
+bool country_store::empty() const { return entries_.empty(); }
+
+const country_entry& country_store::operator[](std::uint32_t index) const {
+    return entries_[index];
+}
+
+std::span<const country_entry> country_store::entries() const { return entries_; }
+
+std::optional<std::uint32_t> country_store::find(iso_code iso) const {
+    if (!iso.valid() || iso_index_[iso.index()] == npos) {
+        return std::nullopt;
+    }
+
+    return iso_index_[iso.index()];
+}
+
+std::optional<std::uint32_t> country_store::find(std::string_view code) const {
+    if (const auto iso = iso_code::from_string(code); iso.valid()) {
+        return find(iso);
+    }
+
+    const auto it = code_ids_.find(code);
+
+    if (it == code_ids_.end() || resolve(it->second) == npos) {
+        return std::nullopt;
+    }
+
+    return resolve(it->second);
+}
+
+std::span<const std::uint32_t> country_store::neighbours(std::uint32_t index) const {
+    assert(linked_ && "link() the store after adding countries");
+
+    return std::span(neighbour_targets_)
+        .subspan(neighbour_offsets_[index],
+                 neighbour_offsets_[index + 1] - neighbour_offsets_[index]);
+}
+
+std::span<const double> country_store::border_km(std::uint32_t index) const {
+    assert(linked_ && "link() the store after adding countries");
+
+    if (target_km_.empty()) {
+        return {};
+    }
+
+    return std::span(target_km_)
+        .subspan(neighbour_offsets_[index],
+                 neighbour_offsets_[index + 1] - neighbour_offsets_[index]);
+}
+
+country country_store::to_country(std::uint32_t index) const {
+    const auto& entry = entries_[index];
+
+    country c;
+    c.name = entry.name;
+    c.iso_code = entry.code;
+    c.capital = entry.capital;
+    c.capital_coords = entry.capital_coords;
+
+    for (std::uint32_t k = 0; k < entry.neighbour_count; k++) {
+        c.neighboring_countries_iso.emplace_back(
+            code_name(neighbour_codes_[entry.first_neighbour + k]));
+    }
+
+    return c;
+}
+
+void to_json(nlohmann::json& j, const country_store& store) {
+    j = nlohmann::json::object();
+
+    for (std::uint32_t i = 0; i < store.size(); i++) {
+        j[std::string(store[i].code)] = store.to_country(i);
+    }
+}
@@ -1,12 +1,13 @@
 #ifndef FETCH_H
 #define FETCH_H
 
+#include <chrono>
 #include <expected>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "country.h"
+#include "request_scheduler.h"
 
 namespace fetch {
 
@@ -15,6 +16,9 @@ struct error {
         status_code_not_200,
         value_not_found,
         parse_error,
+        quota_exhausted,
+        incomplete_result,
+        invalid_rate_limit,
     };
 
     code error_code;
@@ -33,14 +37,36 @@ inline error make_error(error::code code, std::string message, std::string conte
                  .raw_error = std::move(raw_error)};
 }
 
+struct endpoints {
+    std::string restcountries{"https://restcountries.com"};
+    std::string geodatasource{"https://api.geodatasource.com"};
+    // Per request. A request that times out is retried like a 5xx.
+    std::chrono::milliseconds timeout{30000};
+};
+
+struct limits {
+    rate_limit restcountries{.requests_per_second = 10.0, .burst = 10.0, .quota = 0};
+    rate_limit geodatasource{.requests_per_second = 5.0, .burst = 5.0, .quota = 0};
+};
+
+// Sets both limits, or neither when one of them is not valid.
+std::expected<void, error> configure_rate_limits(request_scheduler& scheduler,
+                                                 const endpoints& urls,
+                                                 const limits& rate_limits);
+
 std::expected<std::vector<std::string>, error> fetch_region_codes(
-    const std::string& region);
+    request_scheduler& scheduler, const std::string& region, const endpoints& urls = {});
 
-std::expected<country, error> fetch_country(const std::string& api_key,
-                                            const std::string& iso_code);
+std::expected<country, error> fetch_country(request_scheduler& scheduler,
+                                            const std::string& api_key,
+                                            const std::string& iso_code,
+                                            const endpoints& urls = {});
 
-std::expected<std::unordered_map<std::string, country>, error> fetch_countries(
-    const std::string& api_key, const std::vector<std::string>& iso_codes);
+// Countries that still fail after the scheduler's retries make the whole call
+// fail with incomplete_result, so a throttled run is never cached as complete.
+std::expected<std::vector<country>, error> fetch_countries(
+    request_scheduler& scheduler, const std::string& api_key,
+    const std::vector<std::string>& iso_codes, const endpoints& urls = {});
 }  // namespace fetch
 
 #endif  // !FETCH_H
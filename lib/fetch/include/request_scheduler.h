@@ -0,0 +1,135 @@
+#ifndef REQUEST_SCHEDULER_H
+#define REQUEST_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace fetch {
+
+struct http_response {
+    long status_code{0};
+    std::string text{};
+    std::optional<std::chrono::milliseconds> retry_after{};
+    bool quota_exhausted{false};
+    bool cancelled{false};
+};
+
+struct rate_limit {
+    double requests_per_second{10.0};
+    double burst{10.0};
+    std::size_t quota{0};
+};
+
+// The bucket needs a positive, finite refill rate and room for at least one
+// request, or requests would wait forever.
+bool is_valid(const rate_limit& limit);
+
+struct retry_policy {
+    int max_attempts{6};
+    std::chrono::milliseconds base_delay{250};
+    std::chrono::milliseconds max_delay{30000};
+};
+
+enum class priority {
+    high,
+    normal,
+    low,
+};
+
+struct quota_usage {
+    std::size_t requests;
+    std::size_t retries;
+    std::size_t throttled;
+    std::size_t quota;
+};
+
+std::optional<std::chrono::milliseconds> parse_retry_after(std::string_view value);
+
+class request_scheduler {
+public:
+    using clock = std::chrono::steady_clock;
+
+    explicit request_scheduler(std::size_t workers = 8, retry_policy policy = {});
+    ~request_scheduler();
+
+    request_scheduler(const request_scheduler&) = delete;
+    request_scheduler& operator=(const request_scheduler&) = delete;
+
+    // Returns false and keeps the host's current limit when the new one is not
+    // valid.
+    bool set_rate_limit(const std::string& host, rate_limit limit);
+
+    // Once cancel is requested, a request that has not been sent yet is
+    // answered with a cancelled response instead.
+    std::future<http_response> submit(const std::string& host, priority p,
+                                      std::function<http_response()> request,
+                                      std::stop_token cancel = {});
+
+    quota_usage usage(const std::string& host) const;
+
+private:
+    struct task {
+        std::string host;
+        priority p;
+        std::uint64_t sequence;
+        int attempt;
+        clock::time_point not_before;
+        std::function<http_response()> request;
+        std::stop_token cancel;
+        std::shared_ptr<std::promise<http_response>> result;
+    };
+
+    static bool by_priority(const task& a, const task& b);
+    static bool by_time(const task& a, const task& b);
+
+    // Token bucket with AIMD adaptation: a 429 halves the effective rate and
+    // pauses the host, every success creeps back towards the configured rate.
+    struct bucket {
+        rate_limit limit;
+        double rate;
+        double tokens;
+        clock::time_point refilled_at;
+        clock::time_point paused_until;
+        std::size_t requests;
+        std::size_t retries;
+        std::size_t throttled;
+    };
+
+    void worker_loop(std::stop_token stop);
+    void push_ready(task t);
+    void push_delayed(task t);
+    std::optional<clock::duration> try_acquire(bucket& b, clock::time_point now);
+    void complete(task t, http_response response, clock::time_point now);
+    clock::duration backoff(int attempt);
+    bucket& bucket_for(const std::string& host);
+
+    const retry_policy policy_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::vector<task> ready_;
+    std::vector<task> delayed_;
+    std::unordered_map<std::string, bucket> buckets_;
+    std::uint64_t next_sequence_{0};
+    std::mt19937_64 rng_{std::random_device{}()};
+
+    std::vector<std::jthread> workers_;
+};
+
+}  // namespace fetch
+
+#endif  // !REQUEST_SCHEDULER_H
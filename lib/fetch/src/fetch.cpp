@@ -3,68 +3,79 @@
 #include <cpr/cpr.h>
 
 #include <expected>
-#include <iostream>
+#include <future>
+#include <stop_token>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "country.h"
 #include "nlohmann/json.hpp"
 #include "nlohmann/json_fwd.hpp"
+#include "request_scheduler.h"
 
 using namespace cpr;
 
 namespace fetch {
 
-std::expected<std::vector<std::string>, error> fetch_region_codes(
-    const std::string& region) {
-    Response response = Get(Url{"https://restcountries.com/v3.1/region/" + region});
-
-    if (response.status_code != 200) {
-        return std::unexpected(
-            make_error(error::code::status_code_not_200,
-                       "Failed to fetch region codes for " + region,
-                       "https://restcountries.com/v3.1/region/" + region,
-                       response.status_code, response.text));
-    }
+namespace {
 
-    nlohmann::json countries;
+http_response to_http_response(const Response& response) {
+    http_response result{.status_code = response.status_code, .text = response.text};
 
-    try {
-        countries = nlohmann::json::parse(response.text);
-    } catch (const nlohmann::json::parse_error& e) {
-        return std::unexpected(
-            make_error(error::code::parse_error, "Failed to parse JSON for " + region,
-                       "JSON parsing" + region, response.status_code, e.what()));
+    if (const auto it = response.header.find("Retry-After"); it != response.header.end()) {
+        result.retry_after = parse_retry_after(it->second);
     }
 
-    std::vector<std::string> country_codes;
-
-    for (const auto& country : countries) {
-        if (!country.contains("cca2")) {
-            return std::unexpected(make_error(
-                error::code::value_not_found, "Country code (cca2) not found in response",
-                "Field: cca2" + region, response.status_code, country.dump()));
-        }
+    return result;
+}
 
-        country_codes.emplace_back(country["cca2"]);
+error status_error(const http_response& response, std::string message,
+                   std::string context) {
+    if (response.quota_exhausted) {
+        return make_error(error::code::quota_exhausted, std::move(message),
+                          std::move(context), 0, response.text);
     }
 
-    return country_codes;
+    return make_error(error::code::status_code_not_200, std::move(message),
+                      std::move(context), response.status_code, response.text);
+}
+
+std::future<http_response> request_country(request_scheduler& scheduler,
+                                           const std::string& iso_code, const endpoints& urls,
+                                           std::stop_token cancel = {}) {
+    return scheduler.submit(
+        urls.restcountries, priority::normal,
+        [url = urls.restcountries + "/v3.1/alpha/" + iso_code, timeout = urls.timeout] {
+            return to_http_response(Get(Url{url}, Timeout{timeout}));
+        },
+        std::move(cancel));
 }
 
-std::expected<std::vector<std::string>, error> fetch_neighboring_countries(
-    const std::string& api_key, const std::string& iso_code, const std::string& format) {
-    Response response =
-        Get(Url{"https://api.geodatasource.com/v2/neighboring-countries"},
-            Parameters{{"key", api_key}, {"country_code", iso_code}, {"format", format}});
+std::future<http_response> request_neighboring_countries(request_scheduler& scheduler,
+                                                         const std::string& api_key,
+                                                         const std::string& iso_code,
+                                                         const std::string& format,
+                                                         const endpoints& urls,
+                                                         std::stop_token cancel = {}) {
+    return scheduler.submit(
+        urls.geodatasource, priority::normal,
+        [url = urls.geodatasource + "/v2/neighboring-countries", api_key, iso_code, format,
+         timeout = urls.timeout] {
+            return to_http_response(Get(
+                Url{url},
+                Parameters{{"key", api_key}, {"country_code", iso_code}, {"format", format}},
+                Timeout{timeout}));
+        },
+        std::move(cancel));
+}
 
+std::expected<std::vector<std::string>, error> parse_neighboring_countries(
+    const http_response& response, const std::string& iso_code, const endpoints& urls) {
     if (response.status_code != 200) {
         return std::unexpected(
-            make_error(error::code::status_code_not_200,
-                       "Failed to fetch neighboring countries for " + iso_code,
-                       "https://api.geodatasource.com/v2/neighboring-countries",
-                       response.status_code, response.text));
+            status_error(response, "Failed to fetch neighboring countries for " + iso_code,
+                         urls.geodatasource + "/v2/neighboring-countries"));
     }
 
     nlohmann::json neighbours;
@@ -99,15 +110,12 @@ std::expected<std::vector<std::string>, error> fetch_neighboring_countries(
     return neighbouring_countries;
 }
 
-std::expected<country, error> fetch_country(const std::string& api_key,
+std::expected<country, error> parse_country(const http_response& response,
                                             const std::string& iso_code) {
-    Response response = Get(Url{"https://restcountries.com/v3.1/alpha/" + iso_code});
-
     if (response.status_code != 200) {
-        return std::unexpected(make_error(error::code::status_code_not_200,
-                                          "Failed to fetch country data for " + iso_code,
-                                          "GET /v3.1/alpha/" + iso_code,
-                                          response.status_code, response.text));
+        return std::unexpected(status_error(response,
+                                            "Failed to fetch country data for " + iso_code,
+                                            "GET /v3.1/alpha/" + iso_code));
     }
 
     nlohmann::json parsed;
@@ -160,54 +168,175 @@ std::expected<country, error> fetch_country(const std::string& api_key,
 
     nlohmann::json capital_info = country["capitalInfo"];
 
-    if (!capital_info.contains("latlng")) {
+    // Left empty for countries whose capital has no recorded position.
+    if (capital_info.contains("latlng")) {
+        nlohmann::json latitude_longitude = capital_info["latlng"];
+
+        c.capital_coords = capital_coordinates{.latitude = latitude_longitude[0],
+                                               .longitude = latitude_longitude[1]};
+    }
+
+    c.iso_code = iso_code;
+
+    return c;
+}
+
+}  // namespace
+
+std::expected<void, error> configure_rate_limits(request_scheduler& scheduler,
+                                                 const endpoints& urls,
+                                                 const limits& rate_limits) {
+    for (const auto& [host, limit] : {std::pair(urls.restcountries, rate_limits.restcountries),
+                                      std::pair(urls.geodatasource, rate_limits.geodatasource)}) {
+        if (!is_valid(limit)) {
+            return std::unexpected(make_error(
+                error::code::invalid_rate_limit,
+                "Rate limit for " + host + " needs a positive rate and a burst of at least 1",
+                "configure_rate_limits"));
+        }
+    }
+
+    scheduler.set_rate_limit(urls.restcountries, rate_limits.restcountries);
+    scheduler.set_rate_limit(urls.geodatasource, rate_limits.geodatasource);
+
+    return {};
+}
+
+std::expected<std::vector<std::string>, error> fetch_region_codes(
+    request_scheduler& scheduler, const std::string& region, const endpoints& urls) {
+    const std::string url = urls.restcountries + "/v3.1/region/" + region;
+
+    const http_response response =
+        scheduler
+            .submit(urls.restcountries, priority::high,
+                    [url, timeout = urls.timeout] {
+                        return to_http_response(Get(Url{url}, Timeout{timeout}));
+                    })
+            .get();
+
+    if (response.status_code != 200) {
         return std::unexpected(
-            make_error(error::code::value_not_found,
-                       "Latitude and longitude field not found in capital info data",
-                       "Field: latlng", response.status_code, capital_info.dump()));
+            status_error(response, "Failed to fetch region codes for " + region, url));
     }
 
-    nlohmann::json latitude_longitude = capital_info["latlng"];
+    nlohmann::json countries;
+
+    try {
+        countries = nlohmann::json::parse(response.text);
+    } catch (const nlohmann::json::parse_error& e) {
+        return std::unexpected(
+            make_error(error::code::parse_error, "Failed to parse JSON for " + region,
+                       "JSON parsing" + region, response.status_code, e.what()));
+    }
 
-    c.capital_coords = {.latitude = latitude_longitude[0],
-                        .longitude = latitude_longitude[1]};
+    std::vector<std::string> country_codes;
 
-    c.iso_code = iso_code;
+    for (const auto& country : countries) {
+        if (!country.contains("cca2")) {
+            return std::unexpected(make_error(
+                error::code::value_not_found, "Country code (cca2) not found in response",
+                "Field: cca2" + region, response.status_code, country.dump()));
+        }
+
+        country_codes.emplace_back(country["cca2"]);
+    }
+
+    return country_codes;
+}
+
+std::expected<country, error> fetch_country(request_scheduler& scheduler,
+                                            const std::string& api_key,
+                                            const std::string& iso_code,
+                                            const endpoints& urls) {
+    auto country_response = request_country(scheduler, iso_code, urls);
+    auto neighbours_response =
+        request_neighboring_countries(scheduler, api_key, iso_code, "json", urls);
+
+    auto country_result = parse_country(country_response.get(), iso_code);
+
+    if (!country_result) {
+        return std::unexpected(country_result.error());
+    }
 
     auto neighbouring_countries_result =
-        fetch_neighboring_countries(api_key, iso_code, "json");
+        parse_neighboring_countries(neighbours_response.get(), iso_code, urls);
 
     if (!neighbouring_countries_result) {
         return std::unexpected(neighbouring_countries_result.error());
     }
 
-    c.neighboring_countries_iso = neighbouring_countries_result.value();
+    country_result->neighboring_countries_iso = std::move(*neighbouring_countries_result);
 
-    return c;
+    return country_result;
 }
 
-std::expected<std::unordered_map<std::string, country>, error> fetch_countries(
-    const std::string& api_key, const std::vector<std::string>& iso_codes) {
-    std::unordered_map<std::string, country> countries;
+std::expected<std::vector<country>, error> fetch_countries(
+    request_scheduler& scheduler, const std::string& api_key,
+    const std::vector<std::string>& iso_codes, const endpoints& urls) {
+    std::vector<std::future<http_response>> country_responses;
+    std::vector<std::future<http_response>> neighbours_responses;
+
+    // Requests still queued when a hard error ends the call are not sent, so
+    // they spend no quota.
+    std::stop_source cancel;
+
+    country_responses.reserve(iso_codes.size());
+    neighbours_responses.reserve(iso_codes.size());
+
+    for (const auto& iso_code : iso_codes) {
+        country_responses.push_back(
+            request_country(scheduler, iso_code, urls, cancel.get_token()));
+        neighbours_responses.push_back(request_neighboring_countries(
+            scheduler, api_key, iso_code, "json", urls, cancel.get_token()));
+    }
+
+    std::vector<country> countries;
+    countries.reserve(iso_codes.size());
+
+    std::vector<std::string> missing;
+    error last_error{};
 
     for (size_t i = 0; i < iso_codes.size(); i++) {
-        auto country_result = fetch_country(api_key, iso_codes[i]);
-
-        if (!country_result) {
-            if (country_result.error().error_code == error::code::status_code_not_200) {
-                std::cerr << "Fetch error: " << country_result.error().message
-                          << "\nContext: " << country_result.error().context
-                          << "\nStatus code: " << country_result.error().status_code
-                          << "\nRaw error: " << country_result.error().raw_error
-                          << std::endl;
-                continue;
+        auto country_result = parse_country(country_responses[i].get(), iso_codes[i]);
+
+        std::expected<std::vector<std::string>, error> neighbours_result =
+            parse_neighboring_countries(neighbours_responses[i].get(), iso_codes[i], urls);
+
+        const auto* failure = !country_result       ? &country_result.error()
+                              : !neighbours_result ? &neighbours_result.error()
+                                                   : nullptr;
+
+        // Any status other than 200, 404 included, leaves the country
+        // missing rather than silently dropping it from the region.
+        if (failure != nullptr) {
+            if (failure->error_code != error::code::status_code_not_200 &&
+                failure->error_code != error::code::quota_exhausted) {
+                cancel.request_stop();
+                return std::unexpected(*failure);
             }
 
-            return std::unexpected(country_result.error());
+            missing.push_back(iso_codes[i]);
+            last_error = *failure;
+            continue;
+        }
+
+        country_result->neighboring_countries_iso = std::move(*neighbours_result);
+        countries.push_back(std::move(*country_result));
+    }
+
+    if (!missing.empty()) {
+        std::string missing_codes;
+
+        for (const auto& iso_code : missing) {
+            missing_codes += (missing_codes.empty() ? "" : ", ") + iso_code;
         }
 
-        auto country = country_result.value();
-        countries[country.iso_code] = country;
+        return std::unexpected(make_error(
+            error::code::incomplete_result,
+            "Fetched " + std::to_string(countries.size()) + " of " +
+                std::to_string(iso_codes.size()) + " countries, missing: " + missing_codes,
+            last_error.context, last_error.status_code,
+            last_error.message + "\n" + last_error.raw_error));
     }
 
     return countries;
@@ -0,0 +1,300 @@
+#include "request_scheduler.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace fetch {
+
+namespace {
+
+constexpr double minimum_rate_fraction = 0.05;
+constexpr double rate_recovery_fraction = 0.1;
+
+bool is_retryable(const http_response& response) {
+    return response.status_code == 0 || response.status_code == 429 ||
+           response.status_code >= 500;
+}
+
+}  // namespace
+
+std::optional<std::chrono::milliseconds> parse_retry_after(std::string_view value) {
+    while (!value.empty() && value.front() == ' ') {
+        value.remove_prefix(1);
+    }
+
+    long seconds = 0;
+    const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), seconds);
+
+    if (ec == std::errc{} && end == value.data() + value.size()) {
+        return std::chrono::seconds(std::max(0L, seconds));
+    }
+
+    std::tm tm{};
+    std::istringstream stream{std::string(value)};
+    stream >> std::get_time(&tm, "%a, %d %b %Y %H:%M:%S");
+
+    if (stream.fail()) {
+        return std::nullopt;
+    }
+
+    const auto at = std::chrono::system_clock::from_time_t(timegm(&tm));
+    const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+        at - std::chrono::system_clock::now());
+
+    return std::max(delay, std::chrono::milliseconds(0));
+}
+
+bool is_valid(const rate_limit& limit) {
+    return std::isfinite(limit.requests_per_second) && limit.requests_per_second > 0.0 &&
+           std::isfinite(limit.burst) && limit.burst >= 1.0;
+}
+
+bool request_scheduler::by_priority(const task& a, const task& b) {
+    if (a.p != b.p) {
+        return a.p > b.p;
+    }
+
+    return a.sequence > b.sequence;
+}
+
+bool request_scheduler::by_time(const task& a, const task& b) {
+    return a.not_before > b.not_before;
+}
+
+request_scheduler::request_scheduler(std::size_t workers, retry_policy policy)
+    : policy_(policy) {
+    workers_.reserve(workers);
+
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, workers); i++) {
+        workers_.emplace_back([this](std::stop_token stop) { worker_loop(stop); });
+    }
+}
+
+request_scheduler::~request_scheduler() { workers_.clear(); }
+
+bool request_scheduler::set_rate_limit(const std::string& host, rate_limit limit) {
+    if (!is_valid(limit)) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+
+    bucket& b = bucket_for(host);
+    b.limit = limit;
+    b.rate = limit.requests_per_second;
+    b.tokens = std::min(b.tokens, limit.burst);
+
+    return true;
+}
+
+std::future<http_response> request_scheduler::submit(const std::string& host, priority p,
+                                                     std::function<http_response()> request,
+                                                     std::stop_token cancel) {
+    auto result = std::make_shared<std::promise<http_response>>();
+    auto future = result->get_future();
+
+    {
+        std::lock_guard lock(mutex_);
+        push_ready(task{.host = host,
+                        .p = p,
+                        .sequence = next_sequence_++,
+                        .attempt = 0,
+                        .not_before = clock::now(),
+                        .request = std::move(request),
+                        .cancel = std::move(cancel),
+                        .result = std::move(result)});
+    }
+
+    wake_.notify_one();
+
+    return future;
+}
+
+quota_usage request_scheduler::usage(const std::string& host) const {
+    std::lock_guard lock(mutex_);
+
+    const auto it = buckets_.find(host);
+
+    if (it == buckets_.end()) {
+        return quota_usage{.requests = 0, .retries = 0, .throttled = 0, .quota = 0};
+    }
+
+    return quota_usage{.requests = it->second.requests,
+                       .retries = it->second.retries,
+                       .throttled = it->second.throttled,
+                       .quota = it->second.limit.quota};
+}
+
+void request_scheduler::push_ready(task t) {
+    ready_.push_back(std::move(t));
+    std::ranges::push_heap(ready_, by_priority);
+}
+
+void request_scheduler::push_delayed(task t) {
+    delayed_.push_back(std::move(t));
+    std::ranges::push_heap(delayed_, by_time);
+}
+
+request_scheduler::bucket& request_scheduler::bucket_for(const std::string& host) {
+    auto it = buckets_.find(host);
+
+    if (it == buckets_.end()) {
+        const rate_limit limit{};
+        it = buckets_
+                 .emplace(host, bucket{.limit = limit,
+                                       .rate = limit.requests_per_second,
+                                       .tokens = limit.burst,
+                                       .refilled_at = clock::now(),
+                                       .paused_until = {},
+                                       .requests = 0,
+                                       .retries = 0,
+                                       .throttled = 0})
+                 .first;
+    }
+
+    return it->second;
+}
+
+std::optional<request_scheduler::clock::duration> request_scheduler::try_acquire(
+    bucket& b, clock::time_point now) {
+    if (now < b.paused_until) {
+        return b.paused_until - now;
+    }
+
+    const std::chrono::duration<double> elapsed = now - b.refilled_at;
+    b.tokens = std::min(b.limit.burst, b.tokens + elapsed.count() * b.rate);
+    b.refilled_at = now;
+
+    if (b.tokens >= 1.0) {
+        b.tokens -= 1.0;
+        return std::nullopt;
+    }
+
+    return std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>((1.0 - b.tokens) / b.rate));
+}
+
+request_scheduler::clock::duration request_scheduler::backoff(int attempt) {
+    const auto ceiling = std::min<std::chrono::milliseconds>(
+        policy_.max_delay, policy_.base_delay * (1LL << std::min(attempt, 20)));
+
+    std::uniform_int_distribution<long long> jitter(ceiling.count() / 2, ceiling.count());
+
+    return std::chrono::milliseconds(jitter(rng_));
+}
+
+void request_scheduler::complete(task t, http_response response, clock::time_point now) {
+    bucket& b = bucket_for(t.host);
+
+    if (response.status_code == 429) {
+        b.throttled++;
+        b.rate = std::max(b.limit.requests_per_second * minimum_rate_fraction, b.rate / 2);
+        b.tokens = 0;
+        b.paused_until = std::max(
+            b.paused_until,
+            now + std::chrono::duration_cast<clock::duration>(
+                      response.retry_after.value_or(std::chrono::milliseconds(0))));
+    } else if (response.status_code == 200) {
+        b.rate = std::min(b.limit.requests_per_second,
+                          b.rate + b.limit.requests_per_second * rate_recovery_fraction);
+    }
+
+    if (is_retryable(response) && t.attempt + 1 < policy_.max_attempts) {
+        b.retries++;
+
+        const auto delay =
+            response.retry_after
+                ? std::max<clock::duration>(*response.retry_after, backoff(0))
+                : backoff(t.attempt);
+
+        t.attempt++;
+        t.not_before = now + delay;
+        push_delayed(std::move(t));
+        wake_.notify_one();
+        return;
+    }
+
+    t.result->set_value(std::move(response));
+}
+
+void request_scheduler::worker_loop(std::stop_token stop) {
+    std::unique_lock lock(mutex_);
+
+    while (!stop.stop_requested()) {
+        auto now = clock::now();
+
+        while (!delayed_.empty() && delayed_.front().not_before <= now) {
+            std::ranges::pop_heap(delayed_, by_time);
+            push_ready(std::move(delayed_.back()));
+            delayed_.pop_back();
+        }
+
+        if (ready_.empty()) {
+            if (delayed_.empty()) {
+                wake_.wait(lock, stop, [this] { return !ready_.empty() || !delayed_.empty(); });
+            } else {
+                const auto until = delayed_.front().not_before;
+                wake_.wait_until(lock, stop, until, [this, until] {
+                    return !ready_.empty() ||
+                           (!delayed_.empty() && delayed_.front().not_before < until);
+                });
+            }
+
+            continue;
+        }
+
+        std::ranges::pop_heap(ready_, by_priority);
+        task t = std::move(ready_.back());
+        ready_.pop_back();
+
+        if (t.cancel.stop_requested()) {
+            t.result->set_value(http_response{.status_code = 0,
+                                              .text = "Request cancelled for " + t.host,
+                                              .retry_after = std::nullopt,
+                                              .quota_exhausted = false,
+                                              .cancelled = true});
+            continue;
+        }
+
+        bucket& b = bucket_for(t.host);
+
+        if (b.limit.quota != 0 && b.requests >= b.limit.quota) {
+            t.result->set_value(http_response{.status_code = 0,
+                                              .text = "Request quota exhausted for " + t.host,
+                                              .retry_after = std::nullopt,
+                                              .quota_exhausted = true,
+                                              .cancelled = false});
+            continue;
+        }
+
+        if (const auto wait = try_acquire(b, now)) {
+            t.not_before = now + *wait;
+            push_delayed(std::move(t));
+            continue;
+        }
+
+        b.requests++;
+
+        lock.unlock();
+
+        http_response response;
+
+        try {
+            response = t.request();
+        } catch (...) {
+            t.result->set_exception(std::current_exception());
+            lock.lock();
+            continue;
+        }
+
+        lock.lock();
+
+        complete(std::move(t), std::move(response), clock::now());
+    }
+}
+
+}  // namespace fetch
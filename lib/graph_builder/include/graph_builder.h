@@ -1,9 +1,16 @@
 #ifndef GRAPH_BUILDER_H
 #define GRAPH_BUILDER_H
 
+#include <cstddef>
 #include <expected>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <vector>
+
+#include "country.h"
+#include "fetch.h"
 
 class graph_builder {
 public:
@@ -12,7 +19,10 @@ public:
             region_codes_failed,
             countries_failed,
             countries_write_failed,
-            read_region_file_error
+            read_region_file_error,
+            export_failed,
+            unknown_country,
+            no_capital_coordinates
         };
 
         code error_code;
@@ -21,7 +31,14 @@ public:
         std::string details;     
     };
 
-    explicit graph_builder(std::string geo_data_api_key);
+    struct capital_neighbour {
+        std::string iso_code;
+        std::string name;
+        double distance_km;
+    };
+
+    explicit graph_builder(std::string geo_data_api_key, fetch::endpoints urls = {},
+                           fetch::limits rate_limits = {});
 
     ~graph_builder();
 
@@ -33,6 +50,22 @@ public:
 
     std::expected<void, error> build(const std::string& region);
 
+    // Capital queries load the region on first use and keep it, together with
+    // its spatial index, for later queries and builds.
+    std::expected<capital_coordinates, error> capital_of(const std::string& region,
+                                                         std::string_view iso_code);
+
+    std::expected<std::vector<capital_neighbour>, error> nearest_capitals(
+        const std::string& region, const capital_coordinates& from, std::size_t k);
+    std::expected<std::vector<capital_neighbour>, error> capitals_within(
+        const std::string& region, const capital_coordinates& from, double radius_km);
+
+    std::expected<std::vector<std::vector<capital_neighbour>>, error> nearest_capitals(
+        const std::string& region, std::span<const capital_coordinates> from, std::size_t k);
+    std::expected<std::vector<std::vector<capital_neighbour>>, error> capitals_within(
+        const std::string& region, std::span<const capital_coordinates> from,
+        double radius_km);
+
 private:
     class impl;
     std::unique_ptr<impl> pimpl_;
@@ -1,12 +1,19 @@
 #include "graph_builder.h"
 
 #include <filesystem>
+#include <iostream>
 #include <nlohmann/json.hpp>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "border_adjacency.h"
+#include "capital_index.h"
 #include "country.h"
+#include "country_store.h"
 #include "fetch.h"
 #include "json_file.h"
+#include "region_data.h"
 #include "visual.h"
 
 inline graph_builder::error make_error(graph_builder::error::code code,
@@ -20,24 +27,72 @@ inline graph_builder::error make_error(graph_builder::error::code code,
 
 class graph_builder::impl {
 public:
-    explicit impl(std::string api_key) : geo_data_api_key_(std::move(api_key)) {}
+    impl(std::string api_key, fetch::endpoints urls, const fetch::limits& rate_limits)
+        : geo_data_api_key_(std::move(api_key)), urls_(std::move(urls)) {
+        if (auto configured = fetch::configure_rate_limits(scheduler_, urls_, rate_limits);
+            !configured) {
+            std::cerr << "Warning: " << configured.error().message
+                      << ", using the default limits" << std::endl;
+            fetch::configure_rate_limits(scheduler_, urls_, {});
+        }
+    }
 
     std::expected<void, error> build(const std::string& region);
 
+    std::expected<capital_coordinates, error> capital_of(const std::string& region,
+                                                         std::string_view iso_code);
+
+    std::expected<std::vector<capital_neighbour>, error> nearest_capitals(
+        const std::string& region, const capital_coordinates& from, std::size_t k);
+    std::expected<std::vector<capital_neighbour>, error> capitals_within(
+        const std::string& region, const capital_coordinates& from, double radius_km);
+
+    std::expected<std::vector<std::vector<capital_neighbour>>, error> nearest_capitals(
+        const std::string& region, std::span<const capital_coordinates> from, std::size_t k);
+    std::expected<std::vector<std::vector<capital_neighbour>>, error> capitals_within(
+        const std::string& region, std::span<const capital_coordinates> from,
+        double radius_km);
+
 private:
-    std::expected<std::unordered_map<std::string, country>, error> fetch_countries(
+    struct loaded_region {
+        explicit loaded_region(country_store store)
+            : countries(std::move(store)), capitals(countries) {}
+
+        country_store countries;
+        spatial::capital_index capitals;
+    };
+
+    std::expected<const loaded_region*, error> loaded(const std::string& region);
+
+    static std::vector<capital_neighbour> to_neighbours(const loaded_region& entry,
+                                                        const std::vector<spatial::match>& matches);
+
+    std::expected<std::vector<country>, error> fetch_countries(
         std::string_view region) const;
 
-    std::expected<std::unordered_map<std::string, country>, error>
-    fetch_and_cache_countries(const std::string& region_filename,
-                              const std::string& region) const;
+    std::expected<country_store, error> fetch_and_cache_countries(
+        const std::string& region_filename, const std::string& region) const;
+
+    std::expected<country_store, error> read_countries(
+        const std::string& region_filename) const;
+
+    // Countries or provinces from local GeoJSON outlines, with neighbours
+    // derived from shared borders instead of fetched.
+    std::expected<country_store, error> read_boundaries(
+        const std::string& boundaries_filename) const;
+
+    std::expected<country_store, error> load_countries(const std::string& region) const;
 
     const std::string geo_data_api_key_;
+    const fetch::endpoints urls_;
+    mutable fetch::request_scheduler scheduler_;
+    std::unordered_map<std::string, loaded_region> regions_;
 };
 
-std::expected<std::unordered_map<std::string, country>, graph_builder::error>
+std::expected<std::vector<country>, graph_builder::error>
 graph_builder::impl::fetch_countries(std::string_view region) const {
-    auto region_codes_result = fetch::fetch_region_codes(std::string(region));
+    auto region_codes_result =
+        fetch::fetch_region_codes(scheduler_, std::string(region), urls_);
 
     if (!region_codes_result) {
         const auto& fetch_err = region_codes_result.error();
@@ -50,8 +105,8 @@ graph_builder::impl::fetch_countries(std::string_view region) const {
                 "\n" + "Raw error: " + fetch_err.raw_error));
     }
 
-    auto countries_result =
-        fetch::fetch_countries(geo_data_api_key_, region_codes_result.value());
+    auto countries_result = fetch::fetch_countries(scheduler_, geo_data_api_key_,
+                                                   region_codes_result.value(), urls_);
 
     if (!countries_result) {
         const auto& fetch_err = countries_result.error();
@@ -64,20 +119,30 @@ graph_builder::impl::fetch_countries(std::string_view region) const {
                 "\n" + "Raw error: " + fetch_err.raw_error));
     }
 
-    return countries_result.value();
+    return std::move(countries_result).value();
 }
 
-std::expected<std::unordered_map<std::string, country>, graph_builder::error>
+std::expected<country_store, graph_builder::error>
 graph_builder::impl::fetch_and_cache_countries(const std::string& region_filename,
                                                const std::string& region) const {
     auto countries_result = fetch_countries(region);
 
     if (!countries_result) {
-        return std::unexpected(countries_result.error());
+        return std::unexpected(std::move(countries_result).error());
     }
 
-    nlohmann::json j_umap(countries_result.value());
-    auto write_result = json_file::write(region_filename, j_umap);
+    country_store countries;
+    countries.reserve(countries_result->size(), countries_result->size() * 8);
+
+    // A country the region lists twice is kept once.
+    for (const auto& country : *countries_result) {
+        countries.add(country);
+    }
+
+    countries.link();
+
+    nlohmann::json j_countries(countries);
+    auto write_result = json_file::write(region_filename, j_countries);
 
     if (!write_result) {
         const auto& json_err = write_result.error();
@@ -86,41 +151,207 @@ graph_builder::impl::fetch_and_cache_countries(const std::string& region_filenam
             "File: " + json_err.filename + "\n" + "Details: " + json_err.details));
     }
 
-    return countries_result;
+    return countries;
 }
 
-std::expected<void, graph_builder::error> graph_builder::impl::build(
-    const std::string& region) {
+std::expected<country_store, graph_builder::error> graph_builder::impl::read_countries(
+    const std::string& region_filename) const {
+    auto region_result = json_file::read_countries(region_filename);
+
+    if (!region_result) {
+        const auto& json_err = region_result.error();
+        return std::unexpected(make_error(
+            error::code::read_region_file_error, json_err.message, json_err.operation,
+            "File: " + json_err.filename + "\n" + "Details: " + json_err.details));
+    }
+
+    return std::move(*region_result);
+}
+
+std::expected<country_store, graph_builder::error> graph_builder::impl::read_boundaries(
+    const std::string& boundaries_filename) const {
+    auto boundaries_result = json_file::read_boundaries(boundaries_filename);
+
+    if (!boundaries_result) {
+        const auto& json_err = boundaries_result.error();
+        return std::unexpected(make_error(
+            error::code::read_region_file_error, json_err.message, json_err.operation,
+            "File: " + json_err.filename + "\n" + "Details: " + json_err.details));
+    }
+
+    const auto borders = spatial::find_shared_borders(*boundaries_result);
+
+    return spatial::to_store(*boundaries_result, borders);
+}
+
+std::expected<country_store, graph_builder::error> graph_builder::impl::load_countries(
+    const std::string& region) const {
+    if (const region_data::region* embedded = region_data::find(region)) {
+        return region_data::to_store(*embedded);
+    }
+
+    if (const std::string boundaries_filename = region + ".geojson";
+        std::filesystem::exists(boundaries_filename)) {
+        return read_boundaries(boundaries_filename);
+    }
+
     const std::string region_filename = region + ".json";
-    std::unordered_map<std::string, country> countries;
 
     if (!std::filesystem::exists(region_filename)) {
-        auto fetch_and_cache_result = fetch_and_cache_countries(region_filename, region);
+        return fetch_and_cache_countries(region_filename, region);
+    }
 
-        if (!fetch_and_cache_result) {
-            return std::unexpected(fetch_and_cache_result.error());
-        }
+    return read_countries(region_filename);
+}
 
-        countries = fetch_and_cache_result.value();
-    } else {
-        auto region_result = json_file::read(region_filename);
+std::expected<const graph_builder::impl::loaded_region*, graph_builder::error>
+graph_builder::impl::loaded(const std::string& region) {
+    if (const auto it = regions_.find(region); it != regions_.end()) {
+        return &it->second;
+    }
 
-        if (!region_result) {
-            const auto& json_err = region_result.error();
-            return std::unexpected(make_error(
-                error::code::read_region_file_error, json_err.message, json_err.operation,
-                "File: " + json_err.filename + "\n" + "Details: " + json_err.details));
-        }
+    auto countries_result = load_countries(region);
+
+    if (!countries_result) {
+        return std::unexpected(std::move(countries_result).error());
+    }
+
+    return &regions_.try_emplace(region, std::move(*countries_result)).first->second;
+}
+
+std::vector<graph_builder::capital_neighbour> graph_builder::impl::to_neighbours(
+    const loaded_region& entry, const std::vector<spatial::match>& matches) {
+    std::vector<capital_neighbour> neighbours;
+    neighbours.reserve(matches.size());
+
+    for (const auto& m : matches) {
+        const auto& country = entry.countries[m.index];
+
+        neighbours.push_back({.iso_code = std::string(country.code),
+                              .name = std::string(country.name),
+                              .distance_km = m.distance_km});
+    }
+
+    return neighbours;
+}
+
+std::expected<capital_coordinates, graph_builder::error> graph_builder::impl::capital_of(
+    const std::string& region, std::string_view iso_code) {
+    auto entry = loaded(region);
 
-        countries = region_result.value().get<std::unordered_map<std::string, country>>();
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    const auto index = (*entry)->countries.find(iso_code);
+
+    if (!index) {
+        return std::unexpected(make_error(
+            error::code::unknown_country,
+            "Country '" + std::string(iso_code) + "' is not part of region '" + region + "'",
+            "capital_of"));
+    }
+
+    const auto& coords = (*entry)->countries[*index].capital_coords;
+
+    if (!coords) {
+        return std::unexpected(make_error(
+            error::code::no_capital_coordinates,
+            "Capital of '" + std::string(iso_code) + "' has no coordinates in region '" +
+                region + "'",
+            "capital_of"));
+    }
+
+    return *coords;
+}
+
+std::expected<std::vector<graph_builder::capital_neighbour>, graph_builder::error>
+graph_builder::impl::nearest_capitals(const std::string& region,
+                                      const capital_coordinates& from, std::size_t k) {
+    auto entry = loaded(region);
+
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    return to_neighbours(**entry, (*entry)->capitals.nearest(from, k));
+}
+
+std::expected<std::vector<graph_builder::capital_neighbour>, graph_builder::error>
+graph_builder::impl::capitals_within(const std::string& region,
+                                     const capital_coordinates& from, double radius_km) {
+    auto entry = loaded(region);
+
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    return to_neighbours(**entry, (*entry)->capitals.within(from, radius_km));
+}
+
+std::expected<std::vector<std::vector<graph_builder::capital_neighbour>>, graph_builder::error>
+graph_builder::impl::nearest_capitals(const std::string& region,
+                                      std::span<const capital_coordinates> from,
+                                      std::size_t k) {
+    auto entry = loaded(region);
+
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    std::vector<std::vector<capital_neighbour>> result;
+
+    for (const auto& matches : (*entry)->capitals.nearest(from, k)) {
+        result.push_back(to_neighbours(**entry, matches));
+    }
+
+    return result;
+}
+
+std::expected<std::vector<std::vector<graph_builder::capital_neighbour>>, graph_builder::error>
+graph_builder::impl::capitals_within(const std::string& region,
+                                     std::span<const capital_coordinates> from,
+                                     double radius_km) {
+    auto entry = loaded(region);
+
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    std::vector<std::vector<capital_neighbour>> result;
+
+    for (const auto& matches : (*entry)->capitals.within(from, radius_km)) {
+        result.push_back(to_neighbours(**entry, matches));
+    }
+
+    return result;
+}
+
+std::expected<void, graph_builder::error> graph_builder::impl::build(
+    const std::string& region) {
+    auto entry = loaded(region);
+
+    if (!entry) {
+        return std::unexpected(std::move(entry).error());
+    }
+
+    auto export_result =
+        export_graph((*entry)->countries, region + "graph.svg", region + ".layout.json");
+
+    if (!export_result) {
+        const auto& svg_err = export_result.error();
+        return std::unexpected(
+            make_error(error::code::export_failed, svg_err.message, "Export graph",
+                       "File: " + svg_err.filename + "\n" + "Details: " + svg_err.details));
     }
 
-    export_graph(countries, region + "graph.svg");
     return {};
 }
 
-graph_builder::graph_builder(std::string geo_data_api_key)
-    : pimpl_(std::make_unique<impl>(std::move(geo_data_api_key))) {}
+graph_builder::graph_builder(std::string geo_data_api_key, fetch::endpoints urls,
+                             fetch::limits rate_limits)
+    : pimpl_(std::make_unique<impl>(std::move(geo_data_api_key), std::move(urls),
+                                    rate_limits)) {}
 
 graph_builder::~graph_builder() = default;
 
@@ -131,3 +362,32 @@ std::expected<void, graph_builder::error> graph_builder::build(
     const std::string& region) {
     return pimpl_->build(region);
 }
+
+std::expected<capital_coordinates, graph_builder::error> graph_builder::capital_of(
+    const std::string& region, std::string_view iso_code) {
+    return pimpl_->capital_of(region, iso_code);
+}
+
+std::expected<std::vector<graph_builder::capital_neighbour>, graph_builder::error>
+graph_builder::nearest_capitals(const std::string& region, const capital_coordinates& from,
+                                std::size_t k) {
+    return pimpl_->nearest_capitals(region, from, k);
+}
+
+std::expected<std::vector<graph_builder::capital_neighbour>, graph_builder::error>
+graph_builder::capitals_within(const std::string& region, const capital_coordinates& from,
+                               double radius_km) {
+    return pimpl_->capitals_within(region, from, radius_km);
+}
+
+std::expected<std::vector<std::vector<graph_builder::capital_neighbour>>, graph_builder::error>
+graph_builder::nearest_capitals(const std::string& region,
+                                std::span<const capital_coordinates> from, std::size_t k) {
+    return pimpl_->nearest_capitals(region, from, k);
+}
+
+std::expected<std::vector<std::vector<graph_builder::capital_neighbour>>, graph_builder::error>
+graph_builder::capitals_within(const std::string& region,
+                               std::span<const capital_coordinates> from, double radius_km) {
+    return pimpl_->capitals_within(region, from, radius_km);
+}
@@ -3,7 +3,10 @@
 
 #include <expected>
 #include <string>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include "boundary.h"
+#include "country_store.h"
 #include "nlohmann/json_fwd.hpp"
 
 namespace json_file {
@@ -39,6 +42,19 @@ inline error_info make_error(
 std::expected<void, error_info> write(const std::string& filename, const nlohmann::json& j);
 std::expected<nlohmann::json, error_info> read(const std::string& filename);
 
+// Streams a region cache straight into a country_store without building a json
+// DOM, so loading costs a handful of arena blocks instead of several heap
+// allocations per country.
+std::expected<country_store, error_info> read_countries(const std::string& filename);
+
+// Streams the Polygon and MultiPolygon features of a GeoJSON FeatureCollection
+// (or of a single Feature). Property names are matched case-insensitively: the
+// name is taken from name, name_en or admin and the code from iso_3166_2,
+// iso_a2, iso_code or code, falling back to the feature id and then the name.
+// Features with the same code are merged into one boundary.
+std::expected<std::vector<boundary>, error_info> read_boundaries(
+    const std::string& filename);
+
 }  // namespace json_file
 
 #endif  // !JSON_FILE_H
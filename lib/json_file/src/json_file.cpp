@@ -1,7 +1,20 @@
 #include "json_file.h"
 
+#include <algorithm>
+#include <array>
+#include <cctype>
 #include <fstream>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 #include <system_error>
+#include <unordered_map>
+#include <vector>
+
+#include "boundary.h"
+#include "country_store.h"
 
 #include "nlohmann/json_fwd.hpp"
 
@@ -37,8 +50,10 @@ std::expected<void, error_info> write(const std::string& filename,
     return {};
 }
 
-std::expected<nlohmann::json, error_info> read(const std::string& filename) {
-    std::ifstream file(filename);
+namespace {
+
+std::expected<std::string, error_info> read_content(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
 
     if (!file.is_open()) {
         return std::unexpected(make_error(
@@ -49,8 +64,10 @@ std::expected<nlohmann::json, error_info> read(const std::string& filename) {
 
     std::string content;
     try {
-        content = std::string((std::istreambuf_iterator<char>(file)),
-                              std::istreambuf_iterator<char>());
+        file.seekg(0, std::ios::end);
+        content.resize(static_cast<std::size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        file.read(content.data(), static_cast<std::streamsize>(content.size()));
 
         if (file.fail()) {
             return std::unexpected(
@@ -65,8 +82,535 @@ std::expected<nlohmann::json, error_info> read(const std::string& filename) {
                        filename, "Exception: " + std::string(e.what())));
     }
 
+    return content;
+}
+
+// Expects the cache layout written by graph_builder: an object of countries
+// keyed by ISO code. Every country needs string name, iso_code and capital
+// fields and an array of neighbour codes; capital_coords may be missing or
+// null, but when present it needs a numeric latitude and longitude. Anything
+// else is a parse error, as it was for get<country>, and so is an iso_code
+// used by two countries. Scratch buffers are reused between countries, so once
+// they have grown no further heap allocation happens per country.
+class country_store_sax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit country_store_sax(country_store& store) : store_(store) {}
+
+    bool null() override {
+        if (depth_ == 2 && field_ == field::capital_coords) {
+            return true;
+        }
+
+        return scalar(false, "null");
+    }
+
+    bool boolean(bool) override { return scalar(false, "boolean"); }
+
+    bool number_integer(number_integer_t value) override {
+        return number(static_cast<double>(value));
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        return number(static_cast<double>(value));
+    }
+
+    bool number_float(number_float_t value, const string_t&) override {
+        return number(value);
+    }
+
+    bool string(string_t& value) override {
+        if (depth_ == 2) {
+            if (field_ == field::name) {
+                name_.assign(value);
+            } else if (field_ == field::iso_code) {
+                iso_code_.assign(value);
+            } else if (field_ == field::capital) {
+                capital_.assign(value);
+            }
+        } else if (depth_ == 3 && field_ == field::neighbours) {
+            if (neighbour_count_ == neighbours_.size()) {
+                neighbours_.emplace_back();
+            }
+
+            neighbours_[neighbour_count_++].assign(value);
+            return true;
+        }
+
+        return scalar(true, "string");
+    }
+
+    bool binary(binary_t&) override { return scalar(false, "binary data"); }
+
+    bool start_object(std::size_t) override {
+        if (depth_ == 1) {
+            name_.clear();
+            iso_code_.clear();
+            capital_.clear();
+            coords_.reset();
+            neighbour_count_ = 0;
+            seen_ = 0;
+        } else if (depth_ >= 2 && !container_allowed(field::capital_coords)) {
+            return fail("object");
+        }
+
+        if (depth_ == 2 && field_ == field::capital_coords) {
+            coords_ = capital_coordinates{.latitude = 0.0, .longitude = 0.0};
+            coordinate_ = coordinate::other;
+            seen_ &= ~(seen_latitude | seen_longitude);
+        }
+
+        depth_++;
+        return true;
+    }
+
+    bool end_object() override {
+        depth_--;
+
+        if (depth_ == 2 && field_ == field::capital_coords &&
+            (seen_ & (seen_latitude | seen_longitude)) != (seen_latitude | seen_longitude)) {
+            return fail("capital_coords without latitude and longitude");
+        }
+
+        if (depth_ == 1) {
+            if ((seen_ & seen_required) != seen_required) {
+                return fail("end of country before name, iso_code, capital and "
+                            "neighboring_countries_iso");
+            }
+
+            neighbour_views_.assign(neighbours_.begin(), neighbours_.begin() + neighbour_count_);
+
+            if (store_.add(name_, iso_code_, capital_, coords_, neighbour_views_) ==
+                country_store::npos) {
+                error_ = "Country '" + key_ + "': iso_code '" + iso_code_ +
+                         "' is already used by another country";
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (depth_ < 2 || !container_allowed(field::neighbours)) {
+            return fail("array");
+        }
+
+        if (depth_ == 2 && field_ == field::neighbours) {
+            seen_ |= seen_neighbours;
+        }
+
+        depth_++;
+        return true;
+    }
+
+    bool end_array() override {
+        depth_--;
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        if (depth_ == 1) {
+            key_.assign(value);
+        } else if (depth_ == 2) {
+            field_ = value == "name"                        ? field::name
+                     : value == "iso_code"                  ? field::iso_code
+                     : value == "capital"                   ? field::capital
+                     : value == "capital_coords"            ? field::capital_coords
+                     : value == "neighboring_countries_iso" ? field::neighbours
+                                                            : field::other;
+        } else if (depth_ == 3 && field_ == field::capital_coords) {
+            coordinate_ = value == "latitude"    ? coordinate::latitude
+                          : value == "longitude" ? coordinate::longitude
+                                                 : coordinate::other;
+        }
+
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&,
+                     const nlohmann::detail::exception& e) override {
+        error_ = "Parse error at byte " + std::to_string(position) + ": " + e.what();
+        return false;
+    }
+
+    const std::string& error() const { return error_; }
+
+private:
+    enum class field { name, iso_code, capital, capital_coords, neighbours, other };
+    enum class coordinate { latitude, longitude, other };
+
+    static constexpr unsigned seen_name = 1;
+    static constexpr unsigned seen_iso_code = 2;
+    static constexpr unsigned seen_capital = 4;
+    static constexpr unsigned seen_neighbours = 8;
+    static constexpr unsigned seen_latitude = 16;
+    static constexpr unsigned seen_longitude = 32;
+    static constexpr unsigned seen_required =
+        seen_name | seen_iso_code | seen_capital | seen_neighbours;
+
+    bool fail(std::string_view found) {
+        error_ = depth_ == 0 ? "Expected an object of countries, got " + std::string(found)
+                             : "Country '" + key_ + "': unexpected " + std::string(found);
+        return false;
+    }
+
+    // Unknown fields may hold anything. A known field only opens the one
+    // container it is made of, and only directly.
+    bool container_allowed(field container) const {
+        if (field_ == field::other) {
+            return true;
+        }
+
+        if (depth_ == 2) {
+            return field_ == container;
+        }
+
+        return field_ == field::capital_coords && coordinate_ == coordinate::other;
+    }
+
+    // A scalar anywhere except inside an unknown field.
+    bool scalar(bool is_string, std::string_view found) {
+        if (depth_ <= 1) {
+            return fail(found);
+        }
+
+        if (field_ == field::other ||
+            (depth_ > 2 && field_ == field::capital_coords && coordinate_ == coordinate::other)) {
+            return true;
+        }
+
+        if (depth_ == 2 && is_string) {
+            seen_ |= field_ == field::name       ? seen_name
+                     : field_ == field::iso_code ? seen_iso_code
+                     : field_ == field::capital  ? seen_capital
+                                                 : 0;
+
+            if (field_ != field::neighbours && field_ != field::capital_coords) {
+                return true;
+            }
+        }
+
+        return fail(std::string(found) + " in " + field_name());
+    }
+
+    bool number(double value) {
+        if (depth_ == 3 && field_ == field::capital_coords && coordinate_ != coordinate::other) {
+            if (coordinate_ == coordinate::latitude) {
+                coords_->latitude = value;
+                seen_ |= seen_latitude;
+            } else {
+                coords_->longitude = value;
+                seen_ |= seen_longitude;
+            }
+
+            return true;
+        }
+
+        return scalar(false, "number");
+    }
+
+    const char* field_name() const {
+        switch (field_) {
+            case field::name:
+                return "name";
+            case field::iso_code:
+                return "iso_code";
+            case field::capital:
+                return "capital";
+            case field::capital_coords:
+                return "capital_coords";
+            case field::neighbours:
+                return "neighboring_countries_iso";
+            case field::other:
+                break;
+        }
+
+        return "unknown";
+    }
+
+    country_store& store_;
+
+    int depth_{0};
+    field field_{field::other};
+    coordinate coordinate_{coordinate::other};
+    unsigned seen_{0};
+
+    std::string key_;
+    std::string name_;
+    std::string iso_code_;
+    std::string capital_;
+    std::optional<capital_coordinates> coords_;
+    std::vector<std::string> neighbours_;
+    std::vector<std::string_view> neighbour_views_;
+    std::size_t neighbour_count_{0};
+
+    std::string error_;
+};
+
+// Tracks where in a FeatureCollection the parser is with a stack of frames.
+// Coordinates are recognised by shape rather than by geometry type, which may
+// come after them: an array of numbers is a position and an array of
+// positions is a ring. Only Polygon and MultiPolygon features are kept.
+class boundaries_sax : public nlohmann::json_sax<nlohmann::json> {
+public:
+    explicit boundaries_sax(std::vector<boundary>& boundaries)
+        : boundaries_(boundaries) {}
+
+    bool null() override { return true; }
+
+    bool boolean(bool) override { return true; }
+
+    bool number_integer(number_integer_t value) override {
+        return number(static_cast<double>(value), std::to_string(value));
+    }
+
+    bool number_unsigned(number_unsigned_t value) override {
+        return number(static_cast<double>(value), std::to_string(value));
+    }
+
+    bool number_float(number_float_t value, const string_t& text) override {
+        return number(value, text);
+    }
+
+    bool string(string_t& value) override {
+        value_(value);
+        return true;
+    }
+
+    bool binary(binary_t&) override { return true; }
+
+    bool start_object(std::size_t) override {
+        role r = role::other;
+
+        if (frames_.empty()) {
+            r = role::feature;
+        } else if (frames_.back().kind == role::features) {
+            r = role::feature;
+        } else if (frames_.back().kind == role::feature && key_ == "properties") {
+            r = role::properties;
+        } else if (frames_.back().kind == role::feature && key_ == "geometry") {
+            r = role::geometry;
+        }
+
+        if (r == role::feature) {
+            start_feature();
+        }
+
+        frames_.push_back({.kind = r});
+        return true;
+    }
+
+    bool end_object() override {
+        const role r = frames_.back().kind;
+        frames_.pop_back();
+
+        if (r == role::feature) {
+            finish_feature();
+        }
+
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        role r = role::other;
+
+        if (!frames_.empty()) {
+            frame& parent = frames_.back();
+
+            if (parent.kind == role::feature && key_ == "features") {
+                r = role::features;
+            } else if (parent.kind == role::geometry && key_ == "coordinates") {
+                r = role::coordinates;
+            } else if (parent.kind == role::coordinates) {
+                r = role::coordinates;
+            }
+        }
+
+        frames_.push_back({.kind = r});
+        return true;
+    }
+
+    bool end_array() override {
+        const frame done = frames_.back();
+        frames_.pop_back();
+
+        if (done.kind != role::coordinates) {
+            return true;
+        }
+
+        if (done.numbers >= 2) {
+            ring_.push_back({.longitude = done.longitude, .latitude = done.latitude});
+
+            if (!frames_.empty()) {
+                frames_.back().positions++;
+            }
+        } else if (done.positions > 0) {
+            rings_.push_back(std::move(ring_));
+            ring_.clear();
+        }
+
+        return true;
+    }
+
+    bool key(string_t& value) override {
+        key_.assign(value);
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&,
+                     const nlohmann::detail::exception& e) override {
+        error_ = "Parse error at byte " + std::to_string(position) + ": " + e.what();
+        return false;
+    }
+
+    const std::string& error() const { return error_; }
+
+private:
+    enum class role { features, feature, properties, geometry, coordinates, other };
+
+    struct frame {
+        role kind;
+        int numbers{0};
+        int positions{0};
+        double longitude{0.0};
+        double latitude{0.0};
+    };
+
+    static constexpr std::array<std::string_view, 3> name_keys{"name", "name_en", "admin"};
+    static constexpr std::array<std::string_view, 4> code_keys{"iso_3166_2", "iso_a2",
+                                                               "iso_code", "code"};
+
+    // Lower values win; npos means not found yet.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    static std::size_t rank(std::string_view key, std::span<const std::string_view> keys) {
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            if (key.size() == keys[i].size() &&
+                std::equal(key.begin(), key.end(), keys[i].begin(), [](char a, char b) {
+                    return std::tolower(static_cast<unsigned char>(a)) == b;
+                })) {
+                return i;
+            }
+        }
+
+        return npos;
+    }
+
+    bool number(double value, const std::string& text) {
+        if (frames_.empty()) {
+            return true;
+        }
+
+        frame& current = frames_.back();
+
+        if (current.kind == role::coordinates) {
+            if (current.numbers == 0) {
+                current.longitude = value;
+            } else if (current.numbers == 1) {
+                current.latitude = value;
+            }
+
+            current.numbers++;
+        } else {
+            value_(text);
+        }
+
+        return true;
+    }
+
+    // A string (or a number given as text) directly inside an object.
+    void value_(const std::string& value) {
+        if (frames_.empty()) {
+            return;
+        }
+
+        const role r = frames_.back().kind;
+
+        if (r == role::feature && key_ == "id") {
+            id_ = value;
+        } else if (r == role::geometry && key_ == "type") {
+            type_ = value;
+        } else if (r == role::properties && !value.empty() && value != "-99") {
+            if (const std::size_t i = rank(key_, name_keys); i < name_rank_) {
+                name_rank_ = i;
+                name_ = value;
+            }
+
+            if (const std::size_t i = rank(key_, code_keys); i < code_rank_) {
+                code_rank_ = i;
+                code_ = value;
+            }
+        }
+    }
+
+    void start_feature() {
+        id_.clear();
+        type_.clear();
+        name_.clear();
+        code_.clear();
+        name_rank_ = npos;
+        code_rank_ = npos;
+        ring_.clear();
+        rings_.clear();
+    }
+
+    void finish_feature() {
+        const std::size_t position = features_++;
+
+        if ((type_ != "Polygon" && type_ != "MultiPolygon") || rings_.empty()) {
+            return;
+        }
+
+        std::string code = !code_.empty() ? code_ : !id_.empty() ? id_ : name_;
+
+        // Named after the feature's position in the file.
+        if (code.empty()) {
+            code = "feature_" + std::to_string(position);
+        }
+
+        const auto [it, added] = index_.try_emplace(code, boundaries_.size());
+
+        if (added) {
+            boundaries_.push_back(
+                {.name = name_.empty() ? code : name_, .code = code, .rings = {}});
+        }
+
+        auto& rings = boundaries_[it->second].rings;
+        rings.insert(rings.end(), std::make_move_iterator(rings_.begin()),
+                     std::make_move_iterator(rings_.end()));
+        rings_.clear();
+    }
+
+    std::vector<boundary>& boundaries_;
+    std::unordered_map<std::string, std::size_t> index_;
+    std::size_t features_{0};
+
+    std::vector<frame> frames_;
+    std::string key_;
+
+    std::string id_;
+    std::string type_;
+    std::string name_;
+    std::string code_;
+    std::size_t name_rank_{npos};
+    std::size_t code_rank_{npos};
+    std::vector<geo_point> ring_;
+    std::vector<std::vector<geo_point>> rings_;
+
+    std::string error_;
+};
+
+}  // namespace
+
+std::expected<nlohmann::json, error_info> read(const std::string& filename) {
+    auto content = read_content(filename);
+
+    if (!content) {
+        return std::unexpected(std::move(content).error());
+    }
+
     try {
-        return nlohmann::json::parse(content);
+        return nlohmann::json::parse(*content);
     } catch (const nlohmann::json::parse_error& e) {
         return std::unexpected(make_error(
             error_info::code::failed_parsing,
@@ -75,4 +619,45 @@ std::expected<nlohmann::json, error_info> read(const std::string& filename) {
     }
 }
 
+std::expected<country_store, error_info> read_countries(const std::string& filename) {
+    auto content = read_content(filename);
+
+    if (!content) {
+        return std::unexpected(std::move(content).error());
+    }
+
+    country_store store(content->size());
+    country_store_sax sax(store);
+
+    if (!nlohmann::json::sax_parse(*content, &sax)) {
+        return std::unexpected(make_error(error_info::code::failed_parsing,
+                                          "Failed to parse JSON from file '" + filename + "'",
+                                          "json_parse", filename, sax.error()));
+    }
+
+    store.link();
+
+    return store;
+}
+
+std::expected<std::vector<boundary>, error_info> read_boundaries(
+    const std::string& filename) {
+    auto content = read_content(filename);
+
+    if (!content) {
+        return std::unexpected(std::move(content).error());
+    }
+
+    std::vector<boundary> boundaries;
+    boundaries_sax sax(boundaries);
+
+    if (!nlohmann::json::sax_parse(*content, &sax)) {
+        return std::unexpected(make_error(error_info::code::failed_parsing,
+                                          "Failed to parse GeoJSON from file '" + filename + "'",
+                                          "geojson_parse", filename, sax.error()));
+    }
+
+    return boundaries;
+}
+
 }  // namespace json_file
@@ -0,0 +1,81 @@
+#ifndef ADJACENCY_MATRIX_H
+#define ADJACENCY_MATRIX_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Dense adjacency as one bit row per vertex. Region graphs have at most a few
+// hundred vertices, so the whole matrix stays in cache and neighbourhood
+// intersections become AND + popcount over a handful of words. Rows are padded
+// to whole 256-bit blocks so the AVX2 kernel never needs a scalar tail.
+class adjacency_matrix {
+public:
+    using vertex = std::uint32_t;
+
+    // Largest size() worth a matrix: n^2 / 8 bytes is 512 KiB here, about what
+    // a core's L2 holds. Past it callers should keep using adjacency lists.
+    static constexpr std::size_t dense_limit = 2048;
+
+    adjacency_matrix() = default;
+    explicit adjacency_matrix(std::size_t vertices);
+    // Vertex ids are node indices, so size() is maxNodeIndex() + 1 and indices
+    // of deleted nodes are isolated vertices.
+    explicit adjacency_matrix(const ogdf::Graph& graph);
+
+    std::size_t size() const;
+
+    void add_edge(vertex u, vertex v);
+    void remove_edge(vertex u, vertex v);
+
+    bool has_edge(vertex u, vertex v) const {
+        return (bits_[u * words_ + v / 64] >> (v % 64)) & 1;
+    }
+
+    std::size_t degree(vertex v) const;
+    std::size_t common_neighbours(vertex u, vertex v) const;
+
+    std::span<const std::uint64_t> row(vertex v) const;
+
+    template <typename F>
+    void for_each_neighbour(vertex v, F&& f) const {
+        const std::uint64_t* words = bits_.data() + v * words_;
+
+        for (std::size_t w = 0; w < words_; w++) {
+            for (std::uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+                f(static_cast<vertex>(w * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+            }
+        }
+    }
+
+private:
+    std::size_t vertices_{0};
+    std::size_t words_{0};
+    std::vector<std::uint64_t> bits_;
+};
+
+// Number of set bits in a & b, dispatched to AVX2 or POPCNT when the CPU has them.
+std::size_t and_popcount(const std::uint64_t* a, const std::uint64_t* b, std::size_t words);
+
+std::size_t count_triangles(const adjacency_matrix& graph);
+std::vector<std::uint32_t> triangles_per_vertex(const adjacency_matrix& graph);
+
+// Zero for vertices of degree below two.
+std::vector<double> local_clustering(const adjacency_matrix& graph);
+// Mean over every vertex of the matrix; for a graph with deleted nodes, average
+// local_clustering over the node indices in use instead.
+double average_clustering(const adjacency_matrix& graph);
+// Transitivity: 3 * triangles / connected triples.
+double global_clustering(const adjacency_matrix& graph);
+
+// Batagelj-Zaversnik bucket peeling; the largest core number is the degeneracy.
+std::vector<std::uint32_t> core_numbers(const adjacency_matrix& graph);
+
+// DSATUR colouring; returns one colour per vertex, colours numbered from zero.
+std::vector<std::uint32_t> dsatur_coloring(const adjacency_matrix& graph);
+
+#endif  // !ADJACENCY_MATRIX_H
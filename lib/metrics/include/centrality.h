@@ -0,0 +1,72 @@
+#ifndef CENTRALITY_H
+#define CENTRALITY_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "country_store.h"
+
+// Shortest-path centrality per vertex, from Brandes' algorithm: one single
+// source search per source vertex, with dependencies accumulated back along
+// the search order. Sources are split between worker threads; each thread
+// owns its search buffers and score accumulators, which are summed at the end.
+//
+// Betweenness is normalised by the (n-1)(n-2)/2 pairs it could lie between.
+// Closeness uses the Wasserman-Faust form, r/(n-1) * r/sum, where r is the
+// number of vertices reachable, so it stays comparable across components.
+// Harmonic centrality is the mean of 1/d over the other n-1 vertices.
+struct centrality_scores {
+    std::vector<double> betweenness;
+    std::vector<double> closeness;
+    std::vector<double> harmonic;
+};
+
+enum class centrality_weight {
+    hops,
+    // Great-circle distance between capitals. Equal-length paths are told
+    // apart by hop count, so borders of zero length (capitals without
+    // coordinates) still give a well-defined shortest path order.
+    capital_distance,
+};
+
+struct centrality_options {
+    // Zero uses std::thread::hardware_concurrency().
+    std::size_t threads{0};
+    // Zero runs every vertex as a source. Otherwise that many distinct sources
+    // are drawn uniformly and every sum is scaled by n / samples.
+    std::size_t samples{0};
+    std::uint64_t seed{1};
+};
+
+// Hop-based, indexed by node index.
+centrality_scores compute_centrality(const ogdf::Graph& graph,
+                                     const centrality_options& options = {});
+
+// Indexed by country index in the store.
+centrality_scores compute_centrality(const country_store& countries, centrality_weight weight,
+                                     const centrality_options& options = {});
+
+enum class centrality_measure {
+    betweenness,
+    closeness,
+    harmonic,
+};
+
+struct country_centrality {
+    std::string_view iso_code;
+    std::string_view name;
+    double betweenness;
+    double closeness;
+    double harmonic;
+};
+
+// Highest score first; ties in ISO code order.
+std::vector<country_centrality> rank_countries(const country_store& countries,
+                                               const centrality_scores& scores,
+                                               centrality_measure by);
+
+#endif  // !CENTRALITY_H
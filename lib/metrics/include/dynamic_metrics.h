@@ -0,0 +1,165 @@
+#ifndef DYNAMIC_METRICS_H
+#define DYNAMIC_METRICS_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Keeps the graph metrics up to date while borders and countries are added and
+// removed, so a study that toggles the same border thousands of times does not
+// rebuild the OGDF graph and rerun calculate_metrics for every variant.
+//
+// Vertices are dense ids; a vertex built from an ogdf::Graph keeps its node
+// index. All-pairs hop distances are stored as one BFS row per vertex and
+// only the rows an update actually changes are repaired, which keeps updates
+// local but costs O(n^2) memory, so this is meant for region-sized graphs.
+class dynamic_metrics {
+public:
+    using vertex = std::uint32_t;
+
+    struct change {
+        enum class kind {
+            insert_edge,
+            delete_edge,
+            insert_node,
+            delete_node,
+        };
+
+        kind type;
+        vertex u{0};
+        vertex v{0};
+    };
+
+    struct error {
+        enum class code {
+            unknown_vertex,
+            self_loop,
+        };
+
+        code error_code;
+        std::string message;
+        std::size_t change_index;
+    };
+
+    struct summary {
+        std::size_t number_of_vertices;
+        std::size_t number_of_edges;
+        int components;
+        int biggest_component;
+        int biggest_component_max_degree;
+        int biggest_component_min_degree;
+        int biggest_component_diameter;
+        std::vector<vertex> biggest_component_centers;
+        int cyclomatic_number;
+        int largest_clique;
+        int chromatic_lower_bound;
+        int chromatic_upper_bound;
+        int blocks;
+
+        bool operator==(const summary&) const = default;
+    };
+
+    dynamic_metrics(std::size_t number_of_vertices,
+                    std::span<const std::pair<vertex, vertex>> edges);
+    explicit dynamic_metrics(const ogdf::Graph& graph);
+
+    // Applies the batch in order and returns the metrics of the resulting graph.
+    // Inserting an existing edge or deleting a missing one is a no-op. The batch
+    // is validated up front, so an error leaves the graph untouched.
+    std::expected<summary, error> apply(std::span<const change> batch);
+
+    const summary& current() const;
+
+    // Id the next insert_node change will create.
+    vertex next_vertex() const;
+
+    bool alive(vertex v) const;
+    bool has_edge(vertex u, vertex v) const;
+    std::span<const vertex> neighbours(vertex v) const;
+
+private:
+    static constexpr std::uint16_t unreachable = 0xFFFF;
+    static constexpr std::uint32_t no_component = 0xFFFFFFFF;
+
+    std::expected<void, error> validate(std::span<const change> batch) const;
+
+    vertex insert_node();
+    void delete_node(vertex v);
+    void insert_edge(vertex u, vertex v);
+    void delete_edge(vertex u, vertex v);
+
+    void mark_common_neighbourhood(vertex u, vertex v);
+    void merge_components(vertex u, vertex v);
+    void split_components(vertex u, vertex v);
+    std::uint32_t new_component();
+    void release_component(std::uint32_t component);
+    std::size_t relabel(vertex from, std::uint32_t component);
+    void mark_component(vertex v);
+
+    void relax_rows(vertex u, vertex v);
+    void repair_rows(vertex u, vertex v);
+    void relax_row(vertex source, vertex near, vertex far);
+    void repair_row(vertex source, vertex far);
+    void set_distance(vertex source, vertex target, std::uint16_t distance);
+    void recompute_row(vertex source);
+
+    void recolor(vertex v, bool only_lower);
+    void set_clique(vertex v, int size);
+    int max_clique_through(vertex v) const;
+    int count_blocks(vertex root);
+    std::uint32_t next_stamp();
+
+    void flush();
+    void refresh_summary();
+
+    std::vector<std::vector<vertex>> adjacency_;
+    std::vector<char> alive_;
+    std::size_t vertices_{0};
+    std::size_t edges_{0};
+
+    std::vector<std::uint32_t> component_;
+    std::vector<std::uint32_t> component_size_;
+    std::vector<std::uint32_t> component_blocks_;
+    std::vector<std::uint32_t> free_components_;
+    int components_{0};
+    int blocks_{0};
+
+    // distance_[s][t] is the hop distance between s and t. Since the graph is
+    // undirected the matrix is symmetric, so the rows of an edge's endpoints
+    // tell which other rows the edge can affect. levels_[s][d] counts the
+    // vertices at distance d from s; its size is the eccentricity plus one.
+    std::vector<std::vector<std::uint16_t>> distance_;
+    std::vector<std::vector<std::uint32_t>> levels_;
+
+    std::vector<std::uint32_t> color_;
+    std::vector<std::uint32_t> color_count_;
+    int colors_used_{0};
+
+    std::vector<int> clique_;
+    std::vector<std::uint32_t> clique_count_;
+
+    // Work deferred to the end of a batch.
+    std::vector<char> clique_dirty_;
+    std::vector<vertex> dirty_cliques_;
+    std::vector<vertex> dirty_components_;
+
+    // Stamped visit marks shared by the searches.
+    std::vector<std::uint32_t> mark_;
+    std::vector<char> side_;
+    std::vector<std::uint32_t> order_;
+    std::vector<std::uint32_t> low_;
+    std::uint32_t stamp_{0};
+    std::vector<vertex> queue_;
+    std::vector<vertex> other_queue_;
+    std::vector<vertex> candidates_;
+
+    summary summary_{};
+};
+
+#endif  // !DYNAMIC_METRICS_H
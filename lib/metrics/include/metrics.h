@@ -1,12 +1,47 @@
 #ifndef METRICS_H
 #define METRICS_H
 
+#include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/Graph_d.h>
 
+#include <vector>
+
+#include "adjacency_matrix.h"
+#include "country_store.h"
+
 typedef struct metrics metrics;
 
-metrics* calculate_metrics(ogdf::Graph, ogdf::GraphAttributes);
+// How diameter, centers and distances of the biggest component are found.
+enum class metrics_engine {
+    // Exact up to exact_distance_limit vertices, approximate above.
+    automatic,
+    // A BFS from every vertex.
+    exact,
+    // HyperANF (see neighbourhood_function.h): a diameter lower bound,
+    // effective diameter and average distance with error bounds, and centers
+    // from estimated eccentricities.
+    approximate,
+};
+
+constexpr int exact_distance_limit = 20000;
+
+void extract_component(ogdf::Graph& subgraph, const ogdf::Graph& graph,
+                       const ogdf::NodeArray<int>& components, int component_id);
+std::vector<int> find_graph_centers(const ogdf::Graph& graph);
+int calculate_diameter(const ogdf::Graph& G);
+int find_max_clique(const ogdf::Graph& G);
+// Same greedy search with the bit matrix as adjacency oracle; ids are node indices.
+int find_max_clique(const ogdf::Graph& G, const adjacency_matrix& adjacency);
+
+// graph_attributes must belong to graph; labels name the countries reported.
+metrics* calculate_metrics(const ogdf::Graph& graph, const ogdf::GraphAttributes& graph_attributes,
+                           metrics_engine engine = metrics_engine::automatic);
+// Adds the countries with the highest betweenness by hops and by capital
+// distance, ranked from the store, which must be the one graph was built from.
+metrics* calculate_metrics(const country_store& countries, const ogdf::Graph& graph,
+                           const ogdf::GraphAttributes& graph_attributes,
+                           metrics_engine engine = metrics_engine::automatic);
 void print_metrics(metrics*, ogdf::GraphAttributes&);
 void delete_metrics(metrics*);
 
@@ -0,0 +1,64 @@
+#ifndef NEIGHBOURHOOD_FUNCTION_H
+#define NEIGHBOURHOOD_FUNCTION_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Approximate neighbourhood function (HyperANF, Boldi, Rosa and Vigna). Every
+// vertex keeps a HyperLogLog counter of the vertices within t hops of it, and
+// one iteration merges each counter with those of its neighbours, so after t
+// iterations the counters estimate the balls of radius t. An iteration costs
+// O((n + m) 2^b) and only vertices next to a counter that grew are revisited,
+// instead of the O(nm) of a BFS from every vertex.
+struct hyperanf_options {
+    // Counters have 2^log2_registers one-byte registers, 4 to 16. A counter
+    // estimates its ball with a relative standard error of 1.04 / sqrt(2^b).
+    unsigned log2_registers{7};
+    // Zero uses std::thread::hardware_concurrency().
+    std::size_t threads{0};
+    std::uint64_t seed{1};
+    // Zero iterates until no counter grows.
+    std::size_t max_iterations{0};
+};
+
+struct neighbourhood_function {
+    std::size_t vertices{0};
+    // pairs[t] estimates the ordered pairs (u, v), u == v included, with
+    // d(u, v) <= t. pairs[0] is exact and the sequence never decreases; the
+    // last entry is the last iteration in which some counter grew.
+    std::vector<double> pairs;
+    // By node index: the last iteration in which the vertex's counter grew.
+    // Never more than its eccentricity within its component; once the ball is
+    // large the last few vertices reached may leave every register unchanged,
+    // so it can fall a few hops short.
+    std::vector<std::uint32_t> eccentricity;
+    // Of every counter, and so of every pairs[t].
+    double relative_standard_error{0.0};
+};
+
+// Bounds are two relative standard errors on every pairs[t], taken in the
+// direction that moves the estimate furthest.
+struct interval_estimate {
+    double value;
+    double low;
+    double high;
+};
+
+neighbourhood_function approximate_neighbourhood_function(
+    const ogdf::Graph& graph, const hyperanf_options& options = {});
+
+// Interpolated number of hops within which `fraction` of the reachable pairs
+// (self pairs included) lie.
+interval_estimate effective_diameter(const neighbourhood_function& nf, double fraction = 0.9);
+
+// Mean distance over ordered pairs of distinct vertices that reach each other.
+interval_estimate average_distance(const neighbourhood_function& nf);
+
+// Node indices of smallest estimated eccentricity. Meant for connected graphs:
+// a small component has small eccentricities.
+std::vector<int> approximate_centers(const ogdf::Graph& graph, const neighbourhood_function& nf);
+
+#endif  // !NEIGHBOURHOOD_FUNCTION_H
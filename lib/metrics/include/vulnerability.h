@@ -0,0 +1,68 @@
+#ifndef VULNERABILITY_H
+#define VULNERABILITY_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+// Connectivity of the graph after a country or border is taken out. Removed
+// countries are not counted as components of their own.
+struct removal_effect {
+    int components;
+    int largest_component;
+
+    bool operator==(const removal_effect&) const = default;
+};
+
+struct vulnerability_report {
+    removal_effect intact;
+    // Node indices of countries whose removal disconnects their component.
+    std::vector<int> articulation_countries;
+    // Edge indices of borders whose removal disconnects their component.
+    std::vector<int> bridge_borders;
+    // Indexed by node and edge index; holes left by deleted nodes or edges
+    // hold the intact effect.
+    std::vector<removal_effect> country_removal;
+    std::vector<removal_effect> border_removal;
+};
+
+// Every single removal answered from one block-cut decomposition: removing a
+// country splits its component into the DFS subtrees separated from it plus
+// the rest, and removing a bridge splits off the subtree below it. Linear in
+// the size of the graph.
+vulnerability_report analyse_vulnerability(const ogdf::Graph& graph);
+
+struct removal {
+    enum class kind {
+        country,
+        border,
+    };
+
+    kind type;
+    // Node index for countries, edge index for borders.
+    int index;
+};
+
+struct removal_error {
+    enum class code {
+        unknown_country,
+        unknown_border,
+    };
+
+    code error_code;
+    std::string message;
+    std::size_t removal_index;
+};
+
+// Connectivity after each prefix of the sequence. The removals are replayed
+// backwards from the final graph, adding countries and borders back into a
+// union-find, so the whole sequence costs near-linear time. Removing something
+// twice, or a border of an already removed country, changes nothing.
+std::expected<std::vector<removal_effect>, removal_error> removal_sequence(
+    const ogdf::Graph& graph, std::span<const removal> sequence);
+
+#endif  // !VULNERABILITY_H
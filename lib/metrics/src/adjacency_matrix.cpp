@@ -0,0 +1,354 @@
+#include "adjacency_matrix.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define ADJACENCY_MATRIX_X86_DISPATCH 1
+#endif
+
+namespace {
+
+constexpr std::size_t block_words = 4;
+
+std::size_t and_popcount_generic(const std::uint64_t* a, const std::uint64_t* b,
+                                 std::size_t words) {
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < words; i++) {
+        count += static_cast<std::size_t>(std::popcount(a[i] & b[i]));
+    }
+
+    return count;
+}
+
+#ifdef ADJACENCY_MATRIX_X86_DISPATCH
+
+__attribute__((target("popcnt"))) std::size_t and_popcount_popcnt(const std::uint64_t* a,
+                                                                   const std::uint64_t* b,
+                                                                   std::size_t words) {
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < words; i++) {
+        count += static_cast<std::size_t>(__builtin_popcountll(a[i] & b[i]));
+    }
+
+    return count;
+}
+
+// Nibble lookup popcount (Mula): each byte is split into two nibbles that index a
+// 16-entry table with vpshufb, and vpsadbw folds the byte counts into 64-bit lanes.
+__attribute__((target("avx2"))) std::size_t and_popcount_avx2(const std::uint64_t* a,
+                                                               const std::uint64_t* b,
+                                                               std::size_t words) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1,
+                                            1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+
+    for (std::size_t i = 0; i + block_words <= words; i += block_words) {
+        const __m256i x = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+
+        const __m256i low = _mm256_and_si256(x, low_mask);
+        const __m256i high = _mm256_and_si256(_mm256_srli_epi16(x, 4), low_mask);
+        const __m256i bytes =
+            _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+
+    std::size_t count = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    for (std::size_t i = words - words % block_words; i < words; i++) {
+        count += static_cast<std::size_t>(std::popcount(a[i] & b[i]));
+    }
+
+    return count;
+}
+
+#endif
+
+using kernel = std::size_t (*)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+
+kernel select_kernel() {
+#ifdef ADJACENCY_MATRIX_X86_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return and_popcount_avx2;
+    }
+
+    if (__builtin_cpu_supports("popcnt")) {
+        return and_popcount_popcnt;
+    }
+#endif
+
+    return and_popcount_generic;
+}
+
+const kernel and_popcount_kernel = select_kernel();
+
+}  // namespace
+
+std::size_t and_popcount(const std::uint64_t* a, const std::uint64_t* b, std::size_t words) {
+    return and_popcount_kernel(a, b, words);
+}
+
+adjacency_matrix::adjacency_matrix(std::size_t vertices)
+    : vertices_(vertices),
+      words_((vertices + 64 * block_words - 1) / (64 * block_words) * block_words),
+      bits_(vertices * words_, 0) {}
+
+adjacency_matrix::adjacency_matrix(const ogdf::Graph& graph)
+    : adjacency_matrix(static_cast<std::size_t>(graph.maxNodeIndex() + 1)) {
+    for (ogdf::edge e : graph.edges) {
+        const auto u = static_cast<vertex>(e->source()->index());
+        const auto v = static_cast<vertex>(e->target()->index());
+
+        if (u != v) {
+            add_edge(u, v);
+        }
+    }
+}
+
+std::size_t adjacency_matrix::size() const { return vertices_; }
+
+void adjacency_matrix::add_edge(vertex u, vertex v) {
+    bits_[u * words_ + v / 64] |= std::uint64_t{1} << (v % 64);
+    bits_[v * words_ + u / 64] |= std::uint64_t{1} << (u % 64);
+}
+
+void adjacency_matrix::remove_edge(vertex u, vertex v) {
+    bits_[u * words_ + v / 64] &= ~(std::uint64_t{1} << (v % 64));
+    bits_[v * words_ + u / 64] &= ~(std::uint64_t{1} << (u % 64));
+}
+
+std::size_t adjacency_matrix::degree(vertex v) const {
+    const std::uint64_t* words = bits_.data() + v * words_;
+    std::size_t count = 0;
+
+    for (std::size_t w = 0; w < words_; w++) {
+        count += static_cast<std::size_t>(std::popcount(words[w]));
+    }
+
+    return count;
+}
+
+std::size_t adjacency_matrix::common_neighbours(vertex u, vertex v) const {
+    return and_popcount(bits_.data() + u * words_, bits_.data() + v * words_, words_);
+}
+
+std::span<const std::uint64_t> adjacency_matrix::row(vertex v) const {
+    return {bits_.data() + v * words_, words_};
+}
+
+std::vector<std::uint32_t> triangles_per_vertex(const adjacency_matrix& graph) {
+    std::vector<std::uint32_t> triangles(graph.size(), 0);
+
+    for (adjacency_matrix::vertex u = 0; u < graph.size(); u++) {
+        std::size_t twice = 0;
+
+        graph.for_each_neighbour(u, [&](adjacency_matrix::vertex v) {
+            twice += graph.common_neighbours(u, v);
+        });
+
+        triangles[u] = static_cast<std::uint32_t>(twice / 2);
+    }
+
+    return triangles;
+}
+
+// Every triangle is seen once from each of its three edges.
+std::size_t count_triangles(const adjacency_matrix& graph) {
+    std::size_t count = 0;
+
+    for (adjacency_matrix::vertex u = 0; u < graph.size(); u++) {
+        graph.for_each_neighbour(u, [&](adjacency_matrix::vertex v) {
+            if (u < v) {
+                count += graph.common_neighbours(u, v);
+            }
+        });
+    }
+
+    return count / 3;
+}
+
+std::vector<double> local_clustering(const adjacency_matrix& graph) {
+    const auto triangles = triangles_per_vertex(graph);
+    std::vector<double> clustering(graph.size(), 0.0);
+
+    for (adjacency_matrix::vertex v = 0; v < graph.size(); v++) {
+        const auto degree = static_cast<double>(graph.degree(v));
+
+        if (degree >= 2) {
+            clustering[v] = 2.0 * triangles[v] / (degree * (degree - 1));
+        }
+    }
+
+    return clustering;
+}
+
+double average_clustering(const adjacency_matrix& graph) {
+    if (graph.size() == 0) {
+        return 0.0;
+    }
+
+    const auto clustering = local_clustering(graph);
+    double sum = 0.0;
+
+    for (const double c : clustering) {
+        sum += c;
+    }
+
+    return sum / static_cast<double>(graph.size());
+}
+
+double global_clustering(const adjacency_matrix& graph) {
+    double triples = 0.0;
+
+    for (adjacency_matrix::vertex v = 0; v < graph.size(); v++) {
+        const auto degree = static_cast<double>(graph.degree(v));
+        triples += degree * (degree - 1) / 2.0;
+    }
+
+    if (triples == 0.0) {
+        return 0.0;
+    }
+
+    return 3.0 * static_cast<double>(count_triangles(graph)) / triples;
+}
+
+std::vector<std::uint32_t> core_numbers(const adjacency_matrix& graph) {
+    const std::size_t n = graph.size();
+
+    std::vector<std::uint32_t> degree(n);
+    std::size_t max_degree = 0;
+
+    for (adjacency_matrix::vertex v = 0; v < n; v++) {
+        degree[v] = static_cast<std::uint32_t>(graph.degree(v));
+        max_degree = std::max<std::size_t>(max_degree, degree[v]);
+    }
+
+    // Vertices sorted by degree with the start of each degree bucket, so a
+    // vertex moves to the next lower bucket by swapping with its first member.
+    std::vector<std::size_t> bucket_start(max_degree + 2, 0);
+
+    for (const std::uint32_t d : degree) {
+        bucket_start[d + 1]++;
+    }
+
+    for (std::size_t d = 1; d < bucket_start.size(); d++) {
+        bucket_start[d] += bucket_start[d - 1];
+    }
+
+    std::vector<adjacency_matrix::vertex> order(n);
+    std::vector<std::size_t> position(n);
+
+    {
+        std::vector<std::size_t> next(bucket_start.begin(), bucket_start.end() - 1);
+
+        for (adjacency_matrix::vertex v = 0; v < n; v++) {
+            position[v] = next[degree[v]]++;
+            order[position[v]] = v;
+        }
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+        const adjacency_matrix::vertex v = order[i];
+
+        graph.for_each_neighbour(v, [&](adjacency_matrix::vertex u) {
+            if (degree[u] <= degree[v]) {
+                return;
+            }
+
+            const std::size_t first = bucket_start[degree[u]];
+            const adjacency_matrix::vertex w = order[first];
+
+            if (w != u) {
+                std::swap(order[position[u]], order[first]);
+                std::swap(position[u], position[w]);
+            }
+
+            bucket_start[degree[u]]++;
+            degree[u]--;
+        });
+    }
+
+    return degree;
+}
+
+std::vector<std::uint32_t> dsatur_coloring(const adjacency_matrix& graph) {
+    constexpr std::uint32_t uncolored = 0xFFFFFFFF;
+
+    const std::size_t n = graph.size();
+
+    std::size_t max_degree = 0;
+    std::vector<std::uint32_t> degree(n);
+
+    for (adjacency_matrix::vertex v = 0; v < n; v++) {
+        degree[v] = static_cast<std::uint32_t>(graph.degree(v));
+        max_degree = std::max<std::size_t>(max_degree, degree[v]);
+    }
+
+    // Colours never exceed max_degree, so each vertex's set of neighbouring
+    // colours fits a fixed-width bit row.
+    const std::size_t color_words = max_degree / 64 + 1;
+
+    std::vector<std::uint64_t> neighbour_colors(n * color_words, 0);
+    std::vector<std::uint32_t> saturation(n, 0);
+    std::vector<std::uint32_t> color(n, uncolored);
+
+    for (std::size_t colored = 0; colored < n; colored++) {
+        adjacency_matrix::vertex next = 0;
+        bool found = false;
+
+        for (adjacency_matrix::vertex v = 0; v < n; v++) {
+            if (color[v] != uncolored) {
+                continue;
+            }
+
+            if (!found || saturation[v] > saturation[next] ||
+                (saturation[v] == saturation[next] && degree[v] > degree[next])) {
+                next = v;
+                found = true;
+            }
+        }
+
+        const std::uint64_t* used = neighbour_colors.data() + next * color_words;
+        std::uint32_t c = 0;
+
+        for (std::size_t w = 0; w < color_words; w++) {
+            if (~used[w] != 0) {
+                c = static_cast<std::uint32_t>(w * 64 +
+                                               static_cast<std::size_t>(std::countr_one(used[w])));
+                break;
+            }
+        }
+
+        color[next] = c;
+
+        graph.for_each_neighbour(next, [&](adjacency_matrix::vertex u) {
+            std::uint64_t& word = neighbour_colors[u * color_words + c / 64];
+            const std::uint64_t bit = std::uint64_t{1} << (c % 64);
+
+            if (!(word & bit)) {
+                word |= bit;
+                saturation[u]++;
+            }
+        });
+    }
+
+    return color;
+}
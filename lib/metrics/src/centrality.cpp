@@ -0,0 +1,432 @@
+#include "centrality.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "capital_index.h"
+#include "country_store.h"
+
+namespace {
+
+constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+
+// Weighted searches work in whole metres. Sums of integers are exact in a
+// double, so two routes of the same length always compare equal no matter in
+// which order their borders were added up.
+constexpr double metres_per_km = 1000.0;
+
+// Sources are handed out in chunks so threads rarely touch the shared counter.
+constexpr std::size_t source_chunk = 8;
+
+// Undirected simple graph; lengths are ignored for hop distances.
+struct adjacency {
+    std::size_t vertices{0};
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> targets;
+    std::vector<double> lengths;
+};
+
+// Parallel and reversed edges collapse into one, self loops are dropped.
+adjacency to_adjacency(std::size_t vertices,
+                       std::vector<std::tuple<std::uint32_t, std::uint32_t, double>>& edges) {
+    for (auto& [u, v, length] : edges) {
+        if (v < u) {
+            std::swap(u, v);
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end(),
+                            [](const auto& a, const auto& b) {
+                                return std::get<0>(a) == std::get<0>(b) &&
+                                       std::get<1>(a) == std::get<1>(b);
+                            }),
+                edges.end());
+
+    adjacency graph;
+    graph.vertices = vertices;
+    graph.offsets.assign(vertices + 1, 0);
+
+    for (const auto& [u, v, length] : edges) {
+        if (u != v) {
+            graph.offsets[u + 1]++;
+            graph.offsets[v + 1]++;
+        }
+    }
+
+    std::partial_sum(graph.offsets.begin(), graph.offsets.end(), graph.offsets.begin());
+
+    graph.targets.resize(graph.offsets.back());
+    graph.lengths.resize(graph.offsets.back());
+
+    std::vector<std::uint32_t> next(graph.offsets.begin(), graph.offsets.end() - 1);
+
+    for (const auto& [u, v, length] : edges) {
+        if (u != v) {
+            graph.targets[next[u]] = v;
+            graph.lengths[next[u]++] = length;
+            graph.targets[next[v]] = u;
+            graph.lengths[next[v]++] = length;
+        }
+    }
+
+    return graph;
+}
+
+// Search buffers and partial sums owned by one thread. Buffers are sized once
+// and only the entries a search touched are reset after it.
+class brandes_worker {
+public:
+    brandes_worker(const adjacency& graph, bool weighted)
+        : betweenness(graph.vertices, 0.0),
+          distance_sum(graph.vertices, 0.0),
+          inverse_sum(graph.vertices, 0.0),
+          reached(graph.vertices, 0),
+          graph_(graph),
+          weighted_(weighted),
+          hops_(graph.vertices, unreached),
+          length_(weighted ? graph.vertices : 0, 0.0),
+          sigma_(graph.vertices, 0.0),
+          delta_(graph.vertices, 0.0) {
+        order_.reserve(graph.vertices);
+
+        if (weighted_) {
+            heap_.reserve(graph.targets.size() + 1);
+        }
+    }
+
+    void run(std::uint32_t source) {
+        if (weighted_) {
+            search_weighted(source);
+        } else {
+            search_hops(source);
+        }
+
+        accumulate(source);
+    }
+
+    std::vector<double> betweenness;
+    std::vector<double> distance_sum;
+    std::vector<double> inverse_sum;
+    std::vector<std::uint32_t> reached;
+
+private:
+    using heap_entry = std::tuple<double, std::uint32_t, std::uint32_t>;
+
+    // The search order doubles as the BFS queue.
+    void search_hops(std::uint32_t source) {
+        hops_[source] = 0;
+        sigma_[source] = 1.0;
+        order_.push_back(source);
+
+        for (std::size_t head = 0; head < order_.size(); head++) {
+            const std::uint32_t v = order_[head];
+
+            for (std::uint32_t k = graph_.offsets[v]; k < graph_.offsets[v + 1]; k++) {
+                const std::uint32_t u = graph_.targets[k];
+
+                if (hops_[u] == unreached) {
+                    hops_[u] = hops_[v] + 1;
+                    order_.push_back(u);
+                }
+
+                if (hops_[u] == hops_[v] + 1) {
+                    sigma_[u] += sigma_[v];
+                }
+            }
+        }
+    }
+
+    // Dijkstra on (length, hops) pairs compared lexicographically; every edge
+    // adds one hop, so settled vertices are never reached again at equal cost.
+    void search_weighted(std::uint32_t source) {
+        hops_[source] = 0;
+        length_[source] = 0.0;
+        sigma_[source] = 1.0;
+
+        heap_.clear();
+        heap_.emplace_back(0.0, 0, source);
+
+        while (!heap_.empty()) {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<>());
+            const auto [length, hops, v] = heap_.back();
+            heap_.pop_back();
+
+            if (length != length_[v] || hops != hops_[v]) {
+                continue;
+            }
+
+            order_.push_back(v);
+
+            for (std::uint32_t k = graph_.offsets[v]; k < graph_.offsets[v + 1]; k++) {
+                const std::uint32_t u = graph_.targets[k];
+                const double candidate = length_[v] + graph_.lengths[k];
+                const std::uint32_t candidate_hops = hops_[v] + 1;
+
+                if (hops_[u] == unreached || candidate < length_[u] ||
+                    (candidate == length_[u] && candidate_hops < hops_[u])) {
+                    length_[u] = candidate;
+                    hops_[u] = candidate_hops;
+                    sigma_[u] = sigma_[v];
+                    heap_.emplace_back(candidate, candidate_hops, u);
+                    std::push_heap(heap_.begin(), heap_.end(), std::greater<>());
+                } else if (candidate == length_[u] && candidate_hops == hops_[u]) {
+                    sigma_[u] += sigma_[v];
+                }
+            }
+        }
+    }
+
+    bool on_shortest_path(std::uint32_t from, std::uint32_t to, std::uint32_t k) const {
+        if (hops_[from] == unreached || hops_[from] + 1 != hops_[to]) {
+            return false;
+        }
+
+        return !weighted_ || length_[from] + graph_.lengths[k] == length_[to];
+    }
+
+    void accumulate(std::uint32_t source) {
+        for (std::size_t i = order_.size(); i-- > 0;) {
+            const std::uint32_t w = order_[i];
+
+            for (std::uint32_t k = graph_.offsets[w]; k < graph_.offsets[w + 1]; k++) {
+                const std::uint32_t v = graph_.targets[k];
+
+                if (on_shortest_path(v, w, k)) {
+                    delta_[v] += sigma_[v] / sigma_[w] * (1.0 + delta_[w]);
+                }
+            }
+
+            if (w != source) {
+                const double distance =
+                    weighted_ ? length_[w] / metres_per_km : static_cast<double>(hops_[w]);
+
+                betweenness[w] += delta_[w];
+                distance_sum[w] += distance;
+                reached[w]++;
+
+                if (distance > 0.0) {
+                    inverse_sum[w] += 1.0 / distance;
+                }
+            }
+        }
+
+        for (const std::uint32_t v : order_) {
+            hops_[v] = unreached;
+            sigma_[v] = 0.0;
+            delta_[v] = 0.0;
+        }
+
+        order_.clear();
+    }
+
+    const adjacency& graph_;
+    const bool weighted_;
+
+    std::vector<std::uint32_t> hops_;
+    std::vector<double> length_;
+    std::vector<double> sigma_;
+    std::vector<double> delta_;
+    std::vector<std::uint32_t> order_;
+    std::vector<heap_entry> heap_;
+};
+
+std::vector<std::uint32_t> pick_sources(std::size_t vertices, const centrality_options& options) {
+    std::vector<std::uint32_t> sources(vertices);
+    std::iota(sources.begin(), sources.end(), 0);
+
+    if (options.samples == 0 || options.samples >= vertices) {
+        return sources;
+    }
+
+    std::mt19937_64 random(options.seed);
+
+    for (std::size_t i = 0; i < options.samples; i++) {
+        std::uniform_int_distribution<std::size_t> pick(i, vertices - 1);
+        std::swap(sources[i], sources[pick(random)]);
+    }
+
+    sources.resize(options.samples);
+
+    return sources;
+}
+
+centrality_scores brandes(const adjacency& graph, bool weighted,
+                          const centrality_options& options) {
+    const std::size_t n = graph.vertices;
+
+    centrality_scores scores;
+    scores.betweenness.assign(n, 0.0);
+    scores.closeness.assign(n, 0.0);
+    scores.harmonic.assign(n, 0.0);
+
+    if (n < 2) {
+        return scores;
+    }
+
+    const std::vector<std::uint32_t> sources = pick_sources(n, options);
+
+    const std::size_t chunks = (sources.size() + source_chunk - 1) / source_chunk;
+    const std::size_t threads = std::clamp<std::size_t>(
+        options.threads != 0 ? options.threads : std::thread::hardware_concurrency(), 1, chunks);
+
+    std::vector<brandes_worker> workers;
+    workers.reserve(threads);
+
+    for (std::size_t t = 0; t < threads; t++) {
+        workers.emplace_back(graph, weighted);
+    }
+
+    std::atomic<std::size_t> next{0};
+
+    auto work = [&](brandes_worker& worker) {
+        for (;;) {
+            const std::size_t begin = next.fetch_add(source_chunk, std::memory_order_relaxed);
+
+            if (begin >= sources.size()) {
+                return;
+            }
+
+            const std::size_t end = std::min(begin + source_chunk, sources.size());
+
+            for (std::size_t i = begin; i < end; i++) {
+                worker.run(sources[i]);
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+
+        for (std::size_t t = 1; t < threads; t++) {
+            pool.emplace_back(work, std::ref(workers[t]));
+        }
+
+        work(workers[0]);
+    }
+
+    const double scale = static_cast<double>(n) / static_cast<double>(sources.size());
+    const double others = static_cast<double>(n - 1);
+    // Every pair is seen from both of its ends, hence the extra half.
+    const double pairs = n > 2 ? others * static_cast<double>(n - 2) : 0.0;
+
+    for (std::size_t v = 0; v < n; v++) {
+        double betweenness = 0.0;
+        double distance_sum = 0.0;
+        double inverse_sum = 0.0;
+        double reached = 0.0;
+
+        for (const auto& worker : workers) {
+            betweenness += worker.betweenness[v];
+            distance_sum += worker.distance_sum[v];
+            inverse_sum += worker.inverse_sum[v];
+            reached += worker.reached[v];
+        }
+
+        if (pairs > 0.0) {
+            scores.betweenness[v] = betweenness * scale / pairs;
+        }
+
+        reached = std::min(reached * scale, others);
+        distance_sum *= scale;
+
+        if (distance_sum > 0.0) {
+            scores.closeness[v] = (reached / others) * (reached / distance_sum);
+        }
+
+        scores.harmonic[v] = inverse_sum * scale / others;
+    }
+
+    return scores;
+}
+
+}  // namespace
+
+centrality_scores compute_centrality(const ogdf::Graph& graph,
+                                     const centrality_options& options) {
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, double>> edges;
+    edges.reserve(graph.numberOfEdges());
+
+    for (ogdf::edge e : graph.edges) {
+        edges.emplace_back(e->source()->index(), e->target()->index(), 1.0);
+    }
+
+    const auto vertices = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+
+    return brandes(to_adjacency(vertices, edges), false, options);
+}
+
+centrality_scores compute_centrality(const country_store& countries, centrality_weight weight,
+                                     const centrality_options& options) {
+    std::vector<std::tuple<std::uint32_t, std::uint32_t, double>> edges;
+
+    for (std::uint32_t i = 0; i < countries.size(); i++) {
+        const auto& from = countries[i].capital_coords;
+
+        for (const std::uint32_t neighbour : countries.neighbours(i)) {
+            const auto& to = countries[neighbour].capital_coords;
+            double length = 1.0;
+
+            if (weight == centrality_weight::capital_distance) {
+                length = from && to
+                             ? std::round(spatial::great_circle_km(*from, *to) * metres_per_km)
+                             : 0.0;
+            }
+
+            edges.emplace_back(i, neighbour, length);
+        }
+    }
+
+    return brandes(to_adjacency(countries.size(), edges),
+                   weight == centrality_weight::capital_distance, options);
+}
+
+std::vector<country_centrality> rank_countries(const country_store& countries,
+                                               const centrality_scores& scores,
+                                               centrality_measure by) {
+    std::vector<country_centrality> ranking;
+    ranking.reserve(countries.size());
+
+    for (std::uint32_t i = 0; i < countries.size(); i++) {
+        ranking.push_back({.iso_code = countries[i].code,
+                           .name = countries[i].name,
+                           .betweenness = scores.betweenness[i],
+                           .closeness = scores.closeness[i],
+                           .harmonic = scores.harmonic[i]});
+    }
+
+    auto score = [by](const country_centrality& c) {
+        switch (by) {
+            case centrality_measure::closeness:
+                return c.closeness;
+            case centrality_measure::harmonic:
+                return c.harmonic;
+            case centrality_measure::betweenness:
+                break;
+        }
+
+        return c.betweenness;
+    };
+
+    std::sort(ranking.begin(), ranking.end(), [&](const auto& a, const auto& b) {
+        const double sa = score(a);
+        const double sb = score(b);
+
+        return sa != sb ? sa > sb : a.iso_code < b.iso_code;
+    });
+
+    return ranking;
+}
@@ -0,0 +1,897 @@
+#include "dynamic_metrics.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t no_color = std::numeric_limits<std::uint32_t>::max();
+
+void expand_clique(const std::vector<std::vector<dynamic_metrics::vertex>>& adjacency, int size,
+                   std::vector<dynamic_metrics::vertex> candidates, int& best) {
+    if (candidates.empty()) {
+        best = std::max(best, size);
+        return;
+    }
+
+    while (!candidates.empty()) {
+        if (size + static_cast<int>(candidates.size()) <= best) {
+            return;
+        }
+
+        const dynamic_metrics::vertex w = candidates.back();
+        candidates.pop_back();
+
+        std::vector<dynamic_metrics::vertex> next;
+        std::set_intersection(candidates.begin(), candidates.end(), adjacency[w].begin(),
+                              adjacency[w].end(), std::back_inserter(next));
+
+        expand_clique(adjacency, size + 1, std::move(next), best);
+    }
+}
+
+std::vector<std::pair<dynamic_metrics::vertex, dynamic_metrics::vertex>> edges_of(
+    const ogdf::Graph& graph) {
+    std::vector<std::pair<dynamic_metrics::vertex, dynamic_metrics::vertex>> edges;
+    edges.reserve(static_cast<std::size_t>(graph.numberOfEdges()));
+
+    for (ogdf::edge e : graph.edges) {
+        edges.emplace_back(static_cast<dynamic_metrics::vertex>(e->source()->index()),
+                           static_cast<dynamic_metrics::vertex>(e->target()->index()));
+    }
+
+    return edges;
+}
+
+}  // namespace
+
+dynamic_metrics::dynamic_metrics(std::size_t number_of_vertices,
+                                 std::span<const std::pair<vertex, vertex>> edges)
+    : adjacency_(number_of_vertices),
+      alive_(number_of_vertices, 1),
+      vertices_(number_of_vertices),
+      component_(number_of_vertices, no_component),
+      distance_(number_of_vertices),
+      levels_(number_of_vertices),
+      color_(number_of_vertices, no_color),
+      clique_(number_of_vertices, 0),
+      clique_dirty_(number_of_vertices, 1),
+      mark_(number_of_vertices, 0),
+      side_(number_of_vertices, 0),
+      order_(number_of_vertices, 0),
+      low_(number_of_vertices, 0) {
+    for (const auto& [u, v] : edges) {
+        if (u != v) {
+            adjacency_[u].push_back(v);
+            adjacency_[v].push_back(u);
+        }
+    }
+
+    for (auto& neighbours : adjacency_) {
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        edges_ += neighbours.size();
+    }
+
+    edges_ /= 2;
+
+    for (vertex v = 0; v < number_of_vertices; v++) {
+        distance_[v].resize(number_of_vertices);
+        recompute_row(v);
+        dirty_cliques_.push_back(v);
+
+        if (component_[v] == no_component) {
+            const std::uint32_t id = new_component();
+
+            component_size_[id] = static_cast<std::uint32_t>(relabel(v, id));
+            dirty_components_.push_back(v);
+        }
+
+        recolor(v, false);
+    }
+
+    flush();
+    refresh_summary();
+}
+
+dynamic_metrics::dynamic_metrics(const ogdf::Graph& graph)
+    : dynamic_metrics(static_cast<std::size_t>(graph.maxNodeIndex() + 1), edges_of(graph)) {
+    std::vector<char> present(adjacency_.size(), 0);
+
+    for (ogdf::node v : graph.nodes) {
+        present[static_cast<std::size_t>(v->index())] = 1;
+    }
+
+    std::vector<change> batch;
+
+    for (vertex v = 0; v < present.size(); v++) {
+        if (!present[v]) {
+            batch.push_back({.type = change::kind::delete_node, .u = v});
+        }
+    }
+
+    if (!batch.empty()) {
+        apply(batch);
+    }
+}
+
+std::expected<dynamic_metrics::summary, dynamic_metrics::error> dynamic_metrics::apply(
+    std::span<const change> batch) {
+    if (auto valid = validate(batch); !valid) {
+        return std::unexpected(valid.error());
+    }
+
+    for (const change& c : batch) {
+        switch (c.type) {
+            case change::kind::insert_edge:
+                insert_edge(c.u, c.v);
+                break;
+            case change::kind::delete_edge:
+                delete_edge(c.u, c.v);
+                break;
+            case change::kind::insert_node:
+                insert_node();
+                break;
+            case change::kind::delete_node:
+                delete_node(c.u);
+                break;
+        }
+    }
+
+    flush();
+    refresh_summary();
+
+    return summary_;
+}
+
+const dynamic_metrics::summary& dynamic_metrics::current() const { return summary_; }
+
+dynamic_metrics::vertex dynamic_metrics::next_vertex() const {
+    return static_cast<vertex>(adjacency_.size());
+}
+
+bool dynamic_metrics::alive(vertex v) const { return v < alive_.size() && alive_[v]; }
+
+bool dynamic_metrics::has_edge(vertex u, vertex v) const {
+    return alive(u) && std::binary_search(adjacency_[u].begin(), adjacency_[u].end(), v);
+}
+
+std::span<const dynamic_metrics::vertex> dynamic_metrics::neighbours(vertex v) const {
+    return adjacency_[v];
+}
+
+std::expected<void, dynamic_metrics::error> dynamic_metrics::validate(
+    std::span<const change> batch) const {
+    auto next = static_cast<vertex>(adjacency_.size());
+    std::unordered_set<vertex> deleted;
+
+    const auto exists = [&](vertex v) {
+        return v < next && (v >= alive_.size() || alive_[v]) && !deleted.contains(v);
+    };
+
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        const change& c = batch[i];
+
+        if (c.type == change::kind::insert_node) {
+            next++;
+            continue;
+        }
+
+        const bool edge_change = c.type != change::kind::delete_node;
+
+        for (const vertex v : {c.u, c.v}) {
+            if (!exists(v)) {
+                return std::unexpected(error{.error_code = error::code::unknown_vertex,
+                                             .message = "Vertex " + std::to_string(v) +
+                                                        " does not exist",
+                                             .change_index = i});
+            }
+
+            if (!edge_change) {
+                break;
+            }
+        }
+
+        if (edge_change && c.u == c.v) {
+            return std::unexpected(error{.error_code = error::code::self_loop,
+                                         .message = "Self loop on vertex " + std::to_string(c.u),
+                                         .change_index = i});
+        }
+
+        if (!edge_change) {
+            deleted.insert(c.u);
+        }
+    }
+
+    return {};
+}
+
+dynamic_metrics::vertex dynamic_metrics::insert_node() {
+    const auto v = static_cast<vertex>(adjacency_.size());
+    const std::size_t n = adjacency_.size() + 1;
+
+    adjacency_.emplace_back();
+    alive_.push_back(1);
+    vertices_++;
+
+    const std::uint32_t id = new_component();
+    component_.push_back(id);
+    component_size_[id] = 1;
+    component_blocks_[id] = 1;
+    blocks_++;
+
+    for (auto& row : distance_) {
+        row.push_back(unreachable);
+    }
+
+    distance_.emplace_back(n, unreachable);
+    distance_.back()[v] = 0;
+    levels_.push_back({1});
+
+    color_.push_back(no_color);
+    clique_.push_back(0);
+
+    clique_dirty_.push_back(0);
+    mark_.push_back(0);
+    side_.push_back(0);
+    order_.push_back(0);
+    low_.push_back(0);
+
+    recolor(v, false);
+    set_clique(v, 1);
+
+    return v;
+}
+
+void dynamic_metrics::delete_node(vertex v) {
+    const std::vector<vertex> neighbours = adjacency_[v];
+
+    for (const vertex w : neighbours) {
+        delete_edge(v, w);
+    }
+
+    // Without its edges the vertex is a component of its own.
+    const std::uint32_t c = component_[v];
+
+    blocks_ -= static_cast<int>(component_blocks_[c]);
+    release_component(c);
+    component_[v] = no_component;
+
+    alive_[v] = 0;
+    vertices_--;
+
+    if (--color_count_[color_[v]] == 0) {
+        colors_used_--;
+    }
+
+    color_[v] = no_color;
+    set_clique(v, 0);
+
+    std::fill(distance_[v].begin(), distance_[v].end(), unreachable);
+    levels_[v].clear();
+}
+
+void dynamic_metrics::insert_edge(vertex u, vertex v) {
+    if (has_edge(u, v)) {
+        return;
+    }
+
+    mark_common_neighbourhood(u, v);
+
+    if (component_[u] != component_[v]) {
+        merge_components(u, v);
+    }
+
+    mark_component(u);
+
+    adjacency_[u].insert(std::upper_bound(adjacency_[u].begin(), adjacency_[u].end(), v), v);
+    adjacency_[v].insert(std::upper_bound(adjacency_[v].begin(), adjacency_[v].end(), u), u);
+    edges_++;
+
+    relax_rows(u, v);
+
+    if (color_[u] == color_[v]) {
+        recolor(adjacency_[u].size() < adjacency_[v].size() ? u : v, false);
+    }
+}
+
+void dynamic_metrics::delete_edge(vertex u, vertex v) {
+    if (!has_edge(u, v)) {
+        return;
+    }
+
+    mark_common_neighbourhood(u, v);
+
+    adjacency_[u].erase(std::lower_bound(adjacency_[u].begin(), adjacency_[u].end(), v));
+    adjacency_[v].erase(std::lower_bound(adjacency_[v].begin(), adjacency_[v].end(), u));
+    edges_--;
+
+    split_components(u, v);
+    repair_rows(u, v);
+
+    recolor(u, true);
+    recolor(v, true);
+}
+
+// A clique changes only if it contains both endpoints, so only the endpoints
+// and their common neighbours need their clique bound repaired.
+void dynamic_metrics::mark_common_neighbourhood(vertex u, vertex v) {
+    const auto mark = [this](vertex w) {
+        if (!clique_dirty_[w]) {
+            clique_dirty_[w] = 1;
+            dirty_cliques_.push_back(w);
+        }
+    };
+
+    mark(u);
+    mark(v);
+
+    const auto& a = adjacency_[u];
+    const auto& b = adjacency_[v];
+
+    for (auto i = a.begin(), j = b.begin(); i != a.end() && j != b.end();) {
+        if (*i < *j) {
+            ++i;
+        } else if (*j < *i) {
+            ++j;
+        } else {
+            mark(*i);
+            ++i;
+            ++j;
+        }
+    }
+}
+
+void dynamic_metrics::merge_components(vertex u, vertex v) {
+    std::uint32_t big = component_[u];
+    std::uint32_t small = component_[v];
+    vertex small_root = v;
+
+    if (component_size_[big] < component_size_[small]) {
+        std::swap(big, small);
+        small_root = u;
+    }
+
+    relabel(small_root, big);
+
+    component_size_[big] += component_size_[small];
+    blocks_ -= static_cast<int>(component_blocks_[small]);
+    release_component(small);
+}
+
+// Searches from both endpoints in lockstep. If the searches meet, the component
+// is still connected; otherwise the side that runs out first is a component of
+// its own, found in time proportional to the smaller side.
+void dynamic_metrics::split_components(vertex u, vertex v) {
+    const std::uint32_t stamp = next_stamp();
+
+    std::vector<vertex>& a = queue_;
+    std::vector<vertex>& b = other_queue_;
+
+    a.assign(1, u);
+    b.assign(1, v);
+    mark_[u] = mark_[v] = stamp;
+    side_[u] = 0;
+    side_[v] = 1;
+
+    std::size_t ia = 0;
+    std::size_t ib = 0;
+
+    const auto step = [&](std::vector<vertex>& queue, std::size_t& index, char side) {
+        const vertex x = queue[index++];
+
+        for (const vertex w : adjacency_[x]) {
+            if (mark_[w] != stamp) {
+                mark_[w] = stamp;
+                side_[w] = side;
+                queue.push_back(w);
+            } else if (side_[w] != side) {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    while (ia < a.size() && ib < b.size()) {
+        if (step(a, ia, 0) || step(b, ib, 1)) {
+            mark_component(u);
+            return;
+        }
+    }
+
+    const std::vector<vertex>& separated = ia == a.size() ? a : b;
+    const std::uint32_t old = component_[u];
+    const std::uint32_t id = new_component();
+
+    for (const vertex x : separated) {
+        component_[x] = id;
+    }
+
+    component_size_[id] = static_cast<std::uint32_t>(separated.size());
+    component_size_[old] -= static_cast<std::uint32_t>(separated.size());
+
+    mark_component(u);
+    mark_component(v);
+}
+
+// Ids of merged and deleted components are handed out again, so the per-
+// component arrays stay as large as the most components alive at once rather
+// than growing with every split.
+std::uint32_t dynamic_metrics::new_component() {
+    components_++;
+
+    if (!free_components_.empty()) {
+        const std::uint32_t id = free_components_.back();
+        free_components_.pop_back();
+
+        return id;
+    }
+
+    component_size_.push_back(0);
+    component_blocks_.push_back(0);
+
+    return static_cast<std::uint32_t>(component_size_.size() - 1);
+}
+
+void dynamic_metrics::release_component(std::uint32_t component) {
+    component_size_[component] = 0;
+    component_blocks_[component] = 0;
+    components_--;
+    free_components_.push_back(component);
+}
+
+std::size_t dynamic_metrics::relabel(vertex from, std::uint32_t component) {
+    const std::uint32_t stamp = next_stamp();
+
+    queue_.assign(1, from);
+    mark_[from] = stamp;
+    component_[from] = component;
+
+    for (std::size_t i = 0; i < queue_.size(); i++) {
+        for (const vertex w : adjacency_[queue_[i]]) {
+            if (mark_[w] != stamp) {
+                mark_[w] = stamp;
+                component_[w] = component;
+                queue_.push_back(w);
+            }
+        }
+    }
+
+    return queue_.size();
+}
+
+void dynamic_metrics::mark_component(vertex v) { dirty_components_.push_back(v); }
+
+// Row s holds d(s, u) and d(s, v) at the same positions as rows u and v hold
+// d(u, s) and d(v, s), so the candidate rows are found by scanning the two
+// endpoint rows before any row is touched. An inserted edge can only shorten
+// paths, so each row whose endpoint distances differ by more than one is
+// repaired by relaxing outwards from the farther endpoint.
+void dynamic_metrics::relax_rows(vertex u, vertex v) {
+    const auto& from_u = distance_[u];
+    const auto& from_v = distance_[v];
+
+    candidates_.clear();
+
+    for (vertex s = 0; s < from_u.size(); s++) {
+        if (from_u[s] > from_v[s] + 1 || from_v[s] > from_u[s] + 1) {
+            candidates_.push_back(s);
+        }
+    }
+
+    for (const vertex s : candidates_) {
+        if (distance_[s][u] < distance_[s][v]) {
+            relax_row(s, u, v);
+        } else {
+            relax_row(s, v, u);
+        }
+    }
+}
+
+void dynamic_metrics::relax_row(vertex source, vertex near, vertex far) {
+    auto& row = distance_[source];
+
+    set_distance(source, far, static_cast<std::uint16_t>(row[near] + 1));
+    queue_.assign(1, far);
+
+    for (std::size_t i = 0; i < queue_.size(); i++) {
+        const vertex x = queue_[i];
+
+        for (const vertex w : adjacency_[x]) {
+            if (row[x] + 1 < row[w]) {
+                set_distance(source, w, static_cast<std::uint16_t>(row[x] + 1));
+                queue_.push_back(w);
+            }
+        }
+    }
+}
+
+// A deleted edge only matters to BFS trees that used it: the endpoints sit on
+// consecutive levels and the farther one has no other parent.
+void dynamic_metrics::repair_rows(vertex u, vertex v) {
+    const auto& from_u = distance_[u];
+    const auto& from_v = distance_[v];
+
+    candidates_.clear();
+
+    for (vertex s = 0; s < from_u.size(); s++) {
+        if (from_u[s] != from_v[s] &&
+            (from_u[s] == from_v[s] + 1 || from_v[s] == from_u[s] + 1)) {
+            candidates_.push_back(s);
+        }
+    }
+
+    for (const vertex s : candidates_) {
+        const auto& row = distance_[s];
+        const vertex far = row[u] > row[v] ? u : v;
+
+        const bool other_parent = std::ranges::any_of(
+            adjacency_[far], [&](vertex w) { return row[w] + 1 == row[far]; });
+
+        if (!other_parent) {
+            repair_row(s, far);
+        }
+    }
+}
+
+// Decremental BFS repair: walking down from far level by level, a vertex loses
+// its distance only if every parent already has. Only those vertices are then
+// re-settled, seeded from their unaffected neighbours.
+void dynamic_metrics::repair_row(vertex source, vertex far) {
+    auto& row = distance_[source];
+    const std::uint32_t stamp = next_stamp();
+
+    queue_.assign(1, far);
+    mark_[far] = stamp;
+    side_[far] = 1;
+
+    for (std::size_t i = 0; i < queue_.size(); i++) {
+        const vertex x = queue_[i];
+
+        for (const vertex w : adjacency_[x]) {
+            if (row[w] != row[x] + 1 || mark_[w] == stamp) {
+                continue;
+            }
+
+            mark_[w] = stamp;
+
+            const bool supported = std::ranges::any_of(adjacency_[w], [&](vertex p) {
+                return row[p] + 1 == row[w] && !(mark_[p] == stamp && side_[p]);
+            });
+
+            side_[w] = !supported;
+
+            if (!supported) {
+                queue_.push_back(w);
+            }
+        }
+    }
+
+    using entry = std::pair<std::uint16_t, vertex>;
+    std::vector<entry> heap;
+
+    for (const vertex x : queue_) {
+        std::uint16_t best = unreachable;
+
+        for (const vertex w : adjacency_[x]) {
+            if (!(mark_[w] == stamp && side_[w]) && row[w] != unreachable) {
+                best = std::min(best, static_cast<std::uint16_t>(row[w] + 1));
+            }
+        }
+
+        set_distance(source, x, unreachable);
+
+        if (best != unreachable) {
+            heap.emplace_back(best, x);
+        }
+    }
+
+    std::ranges::make_heap(heap, std::greater<>{});
+
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, std::greater<>{});
+        const auto [d, x] = heap.back();
+        heap.pop_back();
+
+        if (d >= row[x]) {
+            continue;
+        }
+
+        set_distance(source, x, d);
+
+        for (const vertex w : adjacency_[x]) {
+            if (d + 1 < row[w]) {
+                heap.emplace_back(static_cast<std::uint16_t>(d + 1), w);
+                std::ranges::push_heap(heap, std::greater<>{});
+            }
+        }
+    }
+}
+
+void dynamic_metrics::set_distance(vertex source, vertex target, std::uint16_t distance) {
+    auto& levels = levels_[source];
+    std::uint16_t& current = distance_[source][target];
+
+    if (current != unreachable) {
+        levels[current]--;
+    }
+
+    if (distance != unreachable) {
+        if (distance >= levels.size()) {
+            levels.resize(static_cast<std::size_t>(distance) + 1, 0);
+        }
+
+        levels[distance]++;
+    }
+
+    current = distance;
+
+    while (!levels.empty() && levels.back() == 0) {
+        levels.pop_back();
+    }
+}
+
+void dynamic_metrics::recompute_row(vertex source) {
+    auto& row = distance_[source];
+    auto& levels = levels_[source];
+
+    std::fill(row.begin(), row.end(), unreachable);
+    levels.clear();
+
+    if (!alive_[source]) {
+        return;
+    }
+
+    row[source] = 0;
+    levels.push_back(1);
+    queue_.assign(1, source);
+
+    for (std::size_t i = 0; i < queue_.size(); i++) {
+        const vertex x = queue_[i];
+
+        for (const vertex w : adjacency_[x]) {
+            if (row[w] == unreachable) {
+                row[w] = static_cast<std::uint16_t>(row[x] + 1);
+
+                if (row[w] == levels.size()) {
+                    levels.push_back(0);
+                }
+
+                levels[row[w]]++;
+                queue_.push_back(w);
+            }
+        }
+    }
+}
+
+// Greedy repair: a vertex takes the smallest colour missing from its
+// neighbourhood. With only_lower set it moves only if that colour is smaller,
+// which is how deletions give colours back.
+void dynamic_metrics::recolor(vertex v, bool only_lower) {
+    const auto& neighbours = adjacency_[v];
+    std::vector<char> used(neighbours.size() + 1, 0);
+
+    for (const vertex w : neighbours) {
+        if (color_[w] < used.size()) {
+            used[color_[w]] = 1;
+        }
+    }
+
+    const auto color = static_cast<std::uint32_t>(
+        std::distance(used.begin(), std::find(used.begin(), used.end(), 0)));
+
+    if (color == color_[v] || (only_lower && color > color_[v])) {
+        return;
+    }
+
+    if (color_[v] != no_color && --color_count_[color_[v]] == 0) {
+        colors_used_--;
+    }
+
+    if (color >= color_count_.size()) {
+        color_count_.resize(color + 1, 0);
+    }
+
+    if (color_count_[color]++ == 0) {
+        colors_used_++;
+    }
+
+    color_[v] = color;
+}
+
+void dynamic_metrics::set_clique(vertex v, int size) {
+    if (clique_[v] > 0) {
+        clique_count_[static_cast<std::size_t>(clique_[v])]--;
+    }
+
+    clique_[v] = size;
+
+    if (size > 0) {
+        if (static_cast<std::size_t>(size) >= clique_count_.size()) {
+            clique_count_.resize(static_cast<std::size_t>(size) + 1, 0);
+        }
+
+        clique_count_[static_cast<std::size_t>(size)]++;
+    }
+}
+
+int dynamic_metrics::max_clique_through(vertex v) const {
+    int best = 0;
+    expand_clique(adjacency_, 0, adjacency_[v], best);
+
+    return best + 1;
+}
+
+// Iterative Hopcroft-Tarjan over the component of root. An isolated vertex
+// counts as a block of its own.
+int dynamic_metrics::count_blocks(vertex root) {
+    struct frame {
+        vertex v;
+        vertex parent;
+        std::size_t next;
+    };
+
+    if (adjacency_[root].empty()) {
+        return 1;
+    }
+
+    const std::uint32_t stamp = next_stamp();
+    std::uint32_t time = 0;
+    int blocks = 0;
+
+    std::vector<frame> stack{{root, root, 0}};
+    mark_[root] = stamp;
+    order_[root] = low_[root] = time++;
+
+    while (!stack.empty()) {
+        const std::size_t top = stack.size() - 1;
+        const vertex x = stack[top].v;
+
+        if (stack[top].next < adjacency_[x].size()) {
+            const vertex w = adjacency_[x][stack[top].next++];
+
+            if (w == stack[top].parent) {
+                continue;
+            }
+
+            if (mark_[w] == stamp) {
+                low_[x] = std::min(low_[x], order_[w]);
+            } else {
+                mark_[w] = stamp;
+                order_[w] = low_[w] = time++;
+                stack.push_back({w, x, 0});
+            }
+
+            continue;
+        }
+
+        stack.pop_back();
+
+        if (!stack.empty()) {
+            const vertex parent = stack.back().v;
+            low_[parent] = std::min(low_[parent], low_[x]);
+
+            if (low_[x] >= order_[parent]) {
+                blocks++;
+            }
+        }
+    }
+
+    return blocks;
+}
+
+std::uint32_t dynamic_metrics::next_stamp() {
+    if (++stamp_ == 0) {
+        std::fill(mark_.begin(), mark_.end(), 0);
+        stamp_ = 1;
+    }
+
+    return stamp_;
+}
+
+void dynamic_metrics::flush() {
+    for (const vertex v : dirty_cliques_) {
+        clique_dirty_[v] = 0;
+
+        if (alive_[v]) {
+            set_clique(v, max_clique_through(v));
+        }
+    }
+
+    std::vector<char> counted(component_size_.size(), 0);
+
+    for (const vertex v : dirty_components_) {
+        const std::uint32_t c = component_[v];
+
+        if (!alive_[v] || counted[c]) {
+            continue;
+        }
+
+        counted[c] = 1;
+        blocks_ -= static_cast<int>(component_blocks_[c]);
+        component_blocks_[c] = static_cast<std::uint32_t>(count_blocks(v));
+        blocks_ += static_cast<int>(component_blocks_[c]);
+    }
+
+    dirty_cliques_.clear();
+    dirty_components_.clear();
+}
+
+void dynamic_metrics::refresh_summary() {
+    summary_ = summary{};
+
+    summary_.number_of_vertices = vertices_;
+    summary_.number_of_edges = edges_;
+    summary_.components = components_;
+    summary_.cyclomatic_number =
+        static_cast<int>(edges_) - static_cast<int>(vertices_) + components_;
+    summary_.chromatic_upper_bound = colors_used_;
+    summary_.blocks = blocks_;
+
+    for (std::size_t size = clique_count_.size(); size-- > 0;) {
+        if (clique_count_[size] > 0) {
+            summary_.largest_clique = static_cast<int>(size);
+            break;
+        }
+    }
+
+    summary_.chromatic_lower_bound = summary_.largest_clique;
+
+    // Ties go to the component holding the smallest vertex id, so the choice
+    // depends only on the graph and not on the order of earlier updates.
+    std::uint32_t biggest = no_component;
+
+    for (vertex v = 0; v < alive_.size(); v++) {
+        if (alive_[v] && (biggest == no_component ||
+                          component_size_[component_[v]] > component_size_[biggest])) {
+            biggest = component_[v];
+        }
+    }
+
+    if (biggest == no_component) {
+        return;
+    }
+
+    summary_.biggest_component = static_cast<int>(component_size_[biggest]);
+    summary_.biggest_component_min_degree = std::numeric_limits<int>::max();
+
+    int min_eccentricity = std::numeric_limits<int>::max();
+
+    for (vertex v = 0; v < alive_.size(); v++) {
+        if (!alive_[v] || component_[v] != biggest) {
+            continue;
+        }
+
+        const auto degree = static_cast<int>(adjacency_[v].size());
+        const auto eccentricity = static_cast<int>(levels_[v].size()) - 1;
+
+        summary_.biggest_component_max_degree =
+            std::max(summary_.biggest_component_max_degree, degree);
+        summary_.biggest_component_min_degree =
+            std::min(summary_.biggest_component_min_degree, degree);
+        summary_.biggest_component_diameter =
+            std::max(summary_.biggest_component_diameter, eccentricity);
+
+        if (eccentricity < min_eccentricity) {
+            min_eccentricity = eccentricity;
+            summary_.biggest_component_centers.clear();
+        }
+
+        if (eccentricity == min_eccentricity) {
+            summary_.biggest_component_centers.push_back(v);
+        }
+    }
+}
@@ -9,8 +9,15 @@
 #include <cstddef>
 #include <iostream>
 #include <limits>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "adjacency_matrix.h"
+#include "centrality.h"
+#include "neighbourhood_function.h"
+#include "vulnerability.h"
+
 typedef struct metrics
 {
     std::size_t number_of_vertices;
@@ -20,13 +27,34 @@ typedef struct metrics
     int biggest_component_chromatic_number;
     int biggest_component_max_degree;
     int biggest_component_min_degree;
+    // With approximate distances the diameter is a lower bound and the
+    // centers are estimated.
+    bool approximate_distances;
     int biggest_component_diameter;
     std::vector<int> biggest_component_centers;
+    interval_estimate biggest_component_effective_diameter;
+    interval_estimate biggest_component_average_distance;
+    double distance_relative_error;
     int cyclomatic_number;
     int largest_clique;
     int max_induced_eulerian_subgraph;
     int max_induced_hamiltonian_subgraph;
     int blocks;
+    int articulation_countries;
+    int bridge_borders;
+    // Country whose removal leaves the smallest largest component.
+    std::string most_critical_country;
+    int largest_component_without_most_critical;
+    // ISO codes and scores of the countries with the highest betweenness,
+    // highest first. Only filled in when metrics come with a country store.
+    std::vector<std::pair<std::string, double>> top_betweenness;
+    std::vector<std::pair<std::string, double>> top_weighted_betweenness;
+    // Only filled in when the graph fits adjacency_matrix::dense_limit.
+    bool has_dense_metrics;
+    std::size_t triangles;
+    double global_clustering;
+    double average_clustering;
+    int degeneracy;
 } metrics;
 
 void extract_component(ogdf::Graph& subgraph, const ogdf::Graph& graph,
@@ -97,6 +125,10 @@ int calculate_diameter(const ogdf::Graph& G) {
 }
 
 int find_max_clique(const ogdf::Graph& G) {
+    if (static_cast<std::size_t>(G.maxNodeIndex() + 1) <= adjacency_matrix::dense_limit) {
+        return find_max_clique(G, adjacency_matrix(G));
+    }
+
     int max_clique_size = 0;
 
     for (ogdf::node v : G.nodes) {
@@ -128,7 +160,38 @@ int find_max_clique(const ogdf::Graph& G) {
     return max_clique_size;
 }
 
-metrics* calculate_metrics(ogdf::Graph graph, ogdf::GraphAttributes graph_attributes) {
+int find_max_clique(const ogdf::Graph& G, const adjacency_matrix& adjacency) {
+    int max_clique_size = 0;
+
+    std::vector<adjacency_matrix::vertex> clique;
+
+    for (ogdf::node v : G.nodes) {
+        clique.assign(1, static_cast<adjacency_matrix::vertex>(v->index()));
+
+        for (ogdf::adjEntry adj = v->firstAdj(); adj; adj = adj->succ()) {
+            const auto u = static_cast<adjacency_matrix::vertex>(adj->twinNode()->index());
+            bool canAdd = true;
+
+            for (adjacency_matrix::vertex c : clique) {
+                if (c != u && !adjacency.has_edge(u, c)) {
+                    canAdd = false;
+                    break;
+                }
+            }
+
+            if (canAdd) {
+                clique.push_back(u);
+            }
+        }
+
+        max_clique_size = std::max(max_clique_size, (int)clique.size());
+    }
+
+    return max_clique_size;
+}
+
+metrics* calculate_metrics(const ogdf::Graph& graph, const ogdf::GraphAttributes& graph_attributes,
+                           metrics_engine engine) {
     metrics* m = new metrics();
 
     m->number_of_vertices = graph.numberOfNodes();
@@ -169,16 +232,95 @@ metrics* calculate_metrics(ogdf::Graph graph, ogdf::GraphAttributes graph_attrib
 
     m->biggest_component_chromatic_number = max_degree + 1;
 
-    m->biggest_component_diameter = calculate_diameter(largest_component);
+    // The matrix is indexed by node index, so it is sized by the largest one.
+    const bool dense =
+        static_cast<std::size_t>(graph.maxNodeIndex() + 1) <= adjacency_matrix::dense_limit;
+    const adjacency_matrix adjacency = dense ? adjacency_matrix(graph) : adjacency_matrix();
 
-    m->biggest_component_centers = find_graph_centers(largest_component);
+    if (dense && largest_component.numberOfNodes() > 0) {
+        // DSATUR never looks across components, so the colouring of the whole
+        // graph restricted to the biggest component is that component's own.
+        const auto colors = dsatur_coloring(adjacency);
+        int used = 0;
+
+        for (ogdf::node v : graph.nodes) {
+            if (component_map[v] == largest_comp_idx) {
+                used = std::max(used, static_cast<int>(colors[v->index()]) + 1);
+            }
+        }
+
+        m->biggest_component_chromatic_number = std::min(max_degree + 1, used);
+    }
+
+    m->approximate_distances =
+        engine == metrics_engine::approximate ||
+        (engine == metrics_engine::automatic &&
+         largest_component.numberOfNodes() > exact_distance_limit);
+
+    if (m->approximate_distances) {
+        const neighbourhood_function nf = approximate_neighbourhood_function(largest_component);
+
+        m->biggest_component_diameter = static_cast<int>(nf.pairs.size()) - 1;
+        m->biggest_component_centers = approximate_centers(largest_component, nf);
+        m->biggest_component_effective_diameter = effective_diameter(nf);
+        m->biggest_component_average_distance = average_distance(nf);
+        m->distance_relative_error = nf.relative_standard_error;
+    } else {
+        m->biggest_component_diameter = calculate_diameter(largest_component);
+        m->biggest_component_centers = find_graph_centers(largest_component);
+    }
 
     m->cyclomatic_number = m->number_of_edges - m->number_of_vertices + m->components;
 
-    ogdf::BCTree bcTree(graph);
+    // BCTree wants a mutable graph; the block count does not depend on node
+    // indices, so a copy serves.
+    ogdf::Graph bc_graph(graph);
+    ogdf::BCTree bcTree(bc_graph);
     m->blocks = bcTree.numberOfBComps();
 
-    m->largest_clique = find_max_clique(graph);
+    const vulnerability_report vulnerability = analyse_vulnerability(graph);
+
+    m->articulation_countries = static_cast<int>(vulnerability.articulation_countries.size());
+    m->bridge_borders = static_cast<int>(vulnerability.bridge_borders.size());
+    m->largest_component_without_most_critical = m->biggest_component;
+
+    for (ogdf::node v : graph.nodes) {
+        const int remaining = vulnerability.country_removal[v->index()].largest_component;
+
+        if (remaining < m->largest_component_without_most_critical) {
+            m->largest_component_without_most_critical = remaining;
+            m->most_critical_country =
+                graph_attributes.has(ogdf::GraphAttributes::nodeLabel)
+                    ? graph_attributes.label(v)
+                    : std::to_string(v->index());
+        }
+    }
+
+    m->has_dense_metrics = dense;
+
+    if (dense) {
+        m->largest_clique = find_max_clique(graph, adjacency);
+
+        m->triangles = count_triangles(adjacency);
+        m->global_clustering = global_clustering(adjacency);
+
+        // Indices of deleted nodes are not countries and do not count.
+        const auto clustering = local_clustering(adjacency);
+        double clustering_sum = 0.0;
+
+        for (ogdf::node v : graph.nodes) {
+            clustering_sum += clustering[v->index()];
+        }
+
+        m->average_clustering =
+            graph.numberOfNodes() > 0 ? clustering_sum / graph.numberOfNodes() : 0.0;
+
+        const auto cores = core_numbers(adjacency);
+        m->degeneracy =
+            cores.empty() ? 0 : static_cast<int>(*std::max_element(cores.begin(), cores.end()));
+    } else {
+        m->largest_clique = find_max_clique(graph);
+    }
 
     m->max_induced_eulerian_subgraph = 0;
     m->max_induced_hamiltonian_subgraph = 0;
@@ -186,6 +328,60 @@ metrics* calculate_metrics(ogdf::Graph graph, ogdf::GraphAttributes graph_attrib
     return m;
 }
 
+namespace {
+
+// Exact Brandes is O(nm); past this size a sample of sources is enough to
+// rank the top countries.
+constexpr std::size_t exact_centrality_limit = 2000;
+constexpr std::size_t centrality_samples = 256;
+constexpr std::size_t top_countries = 5;
+
+std::vector<std::pair<std::string, double>> top_by_betweenness(const country_store& countries,
+                                                               centrality_weight weight) {
+    const std::size_t samples = countries.size() > exact_centrality_limit ? centrality_samples : 0;
+    const auto scores = compute_centrality(countries, weight, {.samples = samples});
+    const auto ranking = rank_countries(countries, scores, centrality_measure::betweenness);
+
+    std::vector<std::pair<std::string, double>> top;
+
+    for (std::size_t i = 0; i < std::min(top_countries, ranking.size()); i++) {
+        top.emplace_back(ranking[i].iso_code, ranking[i].betweenness);
+    }
+
+    return top;
+}
+
+void print_ranking(const char* title, const std::vector<std::pair<std::string, double>>& ranking) {
+    if (ranking.empty()) {
+        return;
+    }
+
+    std::cout << title;
+
+    for (std::size_t i = 0; i < ranking.size(); i++) {
+        std::cout << ranking[i].first << " " << ranking[i].second;
+
+        if (i < ranking.size() - 1) {
+            std::cout << ", ";
+        }
+    }
+
+    std::cout << std::endl;
+}
+
+}  // namespace
+
+metrics* calculate_metrics(const country_store& countries, const ogdf::Graph& graph,
+                           const ogdf::GraphAttributes& graph_attributes, metrics_engine engine) {
+    metrics* m = calculate_metrics(graph, graph_attributes, engine);
+
+    m->top_betweenness = top_by_betweenness(countries, centrality_weight::hops);
+    m->top_weighted_betweenness =
+        top_by_betweenness(countries, centrality_weight::capital_distance);
+
+    return m;
+}
+
 void print_metrics(metrics* m, ogdf::GraphAttributes& ga) {
     if (m == nullptr) {
         std::cerr << "Error: Null metrics pointer" << std::endl;
@@ -202,10 +398,25 @@ void print_metrics(metrics* m, ogdf::GraphAttributes& ga) {
               << std::endl;
     std::cout << "Biggest component - min degree: " << m->biggest_component_min_degree
               << std::endl;
-    std::cout << "Biggest component - diameter: " << m->biggest_component_diameter
-              << std::endl;
-
-    std::cout << "Biggest component - centers: ";
+    if (m->approximate_distances) {
+        const interval_estimate& effective = m->biggest_component_effective_diameter;
+        const interval_estimate& average = m->biggest_component_average_distance;
+
+        std::cout << "Biggest component - diameter: at least " << m->biggest_component_diameter
+                  << std::endl;
+        std::cout << "Biggest component - effective diameter (90%): " << effective.value << " ("
+                  << effective.low << " to " << effective.high << ")" << std::endl;
+        std::cout << "Biggest component - average distance: " << average.value << " ("
+                  << average.low << " to " << average.high << ")" << std::endl;
+        std::cout << "Biggest component - distances estimated with HyperANF, relative "
+                     "standard error "
+                  << m->distance_relative_error * 100.0 << "%" << std::endl;
+        std::cout << "Biggest component - centers (estimated): ";
+    } else {
+        std::cout << "Biggest component - diameter: " << m->biggest_component_diameter
+                  << std::endl;
+        std::cout << "Biggest component - centers: ";
+    }
 
     for (size_t i = 0; i < m->biggest_component_centers.size(); ++i) {
         std::cout << m->biggest_component_centers[i];
@@ -225,6 +436,28 @@ void print_metrics(metrics* m, ogdf::GraphAttributes& ga) {
               << m->max_induced_hamiltonian_subgraph << std::endl;
 
     std::cout << "Number of blocks (biconnected components): " << m->blocks << std::endl;
+    std::cout << "Articulation countries: " << m->articulation_countries << std::endl;
+    std::cout << "Bridge borders: " << m->bridge_borders << std::endl;
+
+    if (!m->most_critical_country.empty()) {
+        std::cout << "Most critical country: " << m->most_critical_country
+                  << " (largest component without it: "
+                  << m->largest_component_without_most_critical << ")" << std::endl;
+    }
+
+    print_ranking("Highest betweenness (hops): ", m->top_betweenness);
+    print_ranking("Highest betweenness (capital distance): ", m->top_weighted_betweenness);
+
+    if (!m->has_dense_metrics) {
+        std::cout << "Triangles, clustering and degeneracy: n/a (graph too large)" << std::endl;
+        return;
+    }
+
+    std::cout << "Number of triangles: " << m->triangles << std::endl;
+    std::cout << "Global clustering coefficient: " << m->global_clustering << std::endl;
+    std::cout << "Average local clustering coefficient: " << m->average_clustering
+              << std::endl;
+    std::cout << "Degeneracy (largest k-core): " << m->degeneracy << std::endl;
 }
 
 void delete_metrics(metrics* m) {
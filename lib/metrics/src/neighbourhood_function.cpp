@@ -0,0 +1,428 @@
+#include "neighbourhood_function.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define NEIGHBOURHOOD_FUNCTION_X86_DISPATCH 1
+#endif
+
+namespace {
+
+constexpr unsigned min_log2_registers = 4;
+constexpr unsigned max_log2_registers = 16;
+
+// Vertices are handed out in chunks; each chunk keeps its own partial sum so
+// the totals do not depend on how chunks were split between threads.
+constexpr std::size_t vertex_chunk = 256;
+
+// Number of standard errors behind interval_estimate::low and high.
+constexpr double error_bound_deviations = 2.0;
+
+// 2^-r for every register value a 64-bit hash can produce.
+constexpr auto inverse_powers = [] {
+    std::array<double, 65> powers{};
+
+    for (std::size_t r = 0; r < 64; r++) {
+        powers[r] = 1.0 / static_cast<double>(std::uint64_t{1} << r);
+    }
+
+    powers[64] = powers[63] / 2.0;
+
+    return powers;
+}();
+
+// Registers are one byte each, so a merge is a byte-wise max over a contiguous
+// block that the compiler (or the AVX2 kernel below) does 16 or 32 at a time.
+bool merge_generic(std::uint8_t* into, const std::uint8_t* from, std::size_t registers) {
+    std::uint8_t grew = 0;
+
+    for (std::size_t i = 0; i < registers; i++) {
+        const std::uint8_t merged = std::max(into[i], from[i]);
+        grew |= static_cast<std::uint8_t>(merged ^ into[i]);
+        into[i] = merged;
+    }
+
+    return grew != 0;
+}
+
+#ifdef NEIGHBOURHOOD_FUNCTION_X86_DISPATCH
+
+__attribute__((target("avx2"))) bool merge_avx2(std::uint8_t* into, const std::uint8_t* from,
+                                                std::size_t registers) {
+    __m256i grew = _mm256_setzero_si256();
+    std::size_t i = 0;
+
+    for (; i + 32 <= registers; i += 32) {
+        const __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(into + i));
+        const __m256i merged = _mm256_max_epu8(
+            old, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + i)));
+
+        grew = _mm256_or_si256(grew, _mm256_xor_si256(merged, old));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(into + i), merged);
+    }
+
+    const bool tail_grew = merge_generic(into + i, from + i, registers - i);
+
+    return !_mm256_testz_si256(grew, grew) || tail_grew;
+}
+
+#endif
+
+using kernel = bool (*)(std::uint8_t*, const std::uint8_t*, std::size_t);
+
+kernel select_kernel() {
+#ifdef NEIGHBOURHOOD_FUNCTION_X86_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return merge_avx2;
+    }
+#endif
+
+    return merge_generic;
+}
+
+const kernel merge = select_kernel();
+
+std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+double alpha(std::size_t registers) {
+    switch (registers) {
+        case 16:
+            return 0.673;
+        case 32:
+            return 0.697;
+        case 64:
+            return 0.709;
+        default:
+            return 0.7213 / (1.0 + 1.079 / static_cast<double>(registers));
+    }
+}
+
+// HyperLogLog estimate, with linear counting while most registers are empty.
+double estimate(const std::uint8_t* counter, std::size_t registers) {
+    double sum = 0.0;
+    std::size_t zeros = 0;
+
+    for (std::size_t i = 0; i < registers; i++) {
+        sum += inverse_powers[counter[i]];
+        zeros += counter[i] == 0;
+    }
+
+    const auto m = static_cast<double>(registers);
+    const double raw = alpha(registers) * m * m / sum;
+
+    if (raw <= 2.5 * m && zeros != 0) {
+        return m * std::log(m / static_cast<double>(zeros));
+    }
+
+    return raw;
+}
+
+// First t, linearly interpolated, at which the nondecreasing ratio reaches
+// fraction.
+double crossing(const std::vector<double>& ratio, double fraction) {
+    for (std::size_t t = 0; t < ratio.size(); t++) {
+        if (ratio[t] >= fraction) {
+            if (t == 0) {
+                return 0.0;
+            }
+
+            const double step = ratio[t] - ratio[t - 1];
+
+            return static_cast<double>(t - 1) +
+                   (step > 0.0 ? (fraction - ratio[t - 1]) / step : 1.0);
+        }
+    }
+
+    return static_cast<double>(ratio.size() - 1);
+}
+
+}  // namespace
+
+neighbourhood_function approximate_neighbourhood_function(const ogdf::Graph& graph,
+                                                          const hyperanf_options& options) {
+    const unsigned log2_registers =
+        std::clamp(options.log2_registers, min_log2_registers, max_log2_registers);
+    const std::size_t registers = std::size_t{1} << log2_registers;
+
+    neighbourhood_function nf;
+    nf.vertices = static_cast<std::size_t>(graph.numberOfNodes());
+    nf.eccentricity.assign(static_cast<std::size_t>(graph.maxNodeIndex() + 1), 0);
+    nf.relative_standard_error = 1.04 / std::sqrt(static_cast<double>(registers));
+    nf.pairs.push_back(static_cast<double>(nf.vertices));
+
+    const std::size_t n = nf.vertices;
+
+    if (n == 0) {
+        return nf;
+    }
+
+    // Compact ids in node order, neighbours in CSR form.
+    std::vector<std::uint32_t> id(nf.eccentricity.size());
+    std::vector<std::uint32_t> node_index;
+    node_index.reserve(n);
+
+    for (ogdf::node v : graph.nodes) {
+        id[v->index()] = static_cast<std::uint32_t>(node_index.size());
+        node_index.push_back(static_cast<std::uint32_t>(v->index()));
+    }
+
+    std::vector<std::uint32_t> offsets(n + 1, 0);
+
+    for (ogdf::edge e : graph.edges) {
+        if (e->source() != e->target()) {
+            offsets[id[e->source()->index()] + 1]++;
+            offsets[id[e->target()->index()] + 1]++;
+        }
+    }
+
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::uint32_t> targets(offsets.back());
+    std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (ogdf::edge e : graph.edges) {
+        if (e->source() != e->target()) {
+            const std::uint32_t u = id[e->source()->index()];
+            const std::uint32_t v = id[e->target()->index()];
+
+            targets[fill[u]++] = v;
+            targets[fill[v]++] = u;
+        }
+    }
+
+    // Each counter starts out holding its own vertex.
+    std::vector<std::uint8_t> current(n * registers, 0);
+    std::vector<std::uint8_t> next(n * registers);
+
+    for (std::size_t v = 0; v < n; v++) {
+        const std::uint64_t hash = splitmix64(options.seed ^ splitmix64(v));
+        const std::uint64_t rest = hash << log2_registers;
+        const auto rank = static_cast<std::uint8_t>(
+            rest == 0 ? 64 - log2_registers + 1 : std::countl_zero(rest) + 1);
+
+        current[v * registers + (hash >> (64 - log2_registers))] = rank;
+    }
+
+    std::vector<double> estimates(n, 0.0);
+    std::vector<std::uint8_t> grew(n, 1);
+    std::vector<std::uint8_t> grew_next(n, 0);
+    std::vector<std::uint32_t> last_growth(n, 0);
+
+    const std::size_t chunks = (n + vertex_chunk - 1) / vertex_chunk;
+    std::vector<double> chunk_pairs(chunks, 0.0);
+    std::vector<std::uint8_t> chunk_grew(chunks, 0);
+
+    const std::size_t threads = std::clamp<std::size_t>(
+        options.threads != 0 ? options.threads : std::thread::hardware_concurrency(), 1, chunks);
+
+    std::atomic<std::size_t> next_chunk{0};
+    std::uint32_t iteration = 1;
+    double iteration_pairs = 0.0;
+    bool any_grew = false;
+    bool done = false;
+
+    // Runs on one thread once every chunk of an iteration is merged.
+    auto finish_iteration = [&]() noexcept {
+        iteration_pairs = std::accumulate(chunk_pairs.begin(), chunk_pairs.end(), 0.0);
+        any_grew = std::find(chunk_grew.begin(), chunk_grew.end(), 1) != chunk_grew.end();
+
+        current.swap(next);
+        grew.swap(grew_next);
+        next_chunk.store(0, std::memory_order_relaxed);
+
+        done = !any_grew || (options.max_iterations != 0 && iteration >= options.max_iterations);
+        iteration++;
+    };
+
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads), finish_iteration);
+
+    // A counter only changes when a neighbour's counter grew in the previous
+    // iteration, and then only those neighbours need merging in.
+    auto merge_chunk = [&](std::size_t chunk) {
+        const std::size_t begin = chunk * vertex_chunk;
+        const std::size_t end = std::min(begin + vertex_chunk, n);
+
+        double pairs = 0.0;
+        std::uint8_t any = 0;
+
+        for (std::size_t v = begin; v < end; v++) {
+            // The buffers alternate, so a counter that did not grow last time
+            // already holds the same registers in both.
+            std::uint8_t* counter = next.data() + v * registers;
+
+            if (grew[v]) {
+                std::memcpy(counter, current.data() + v * registers, registers);
+            }
+
+            bool changed = false;
+
+            for (std::uint32_t k = offsets[v]; k < offsets[v + 1]; k++) {
+                const std::uint32_t u = targets[k];
+
+                if (grew[u]) {
+                    changed |= merge(counter, current.data() + u * registers, registers);
+                }
+            }
+
+            if (changed) {
+                estimates[v] = estimate(counter, registers);
+                last_growth[v] = iteration;
+            }
+
+            grew_next[v] = changed;
+            any |= changed;
+            pairs += estimates[v];
+        }
+
+        chunk_pairs[chunk] = pairs;
+        chunk_grew[chunk] = any;
+    };
+
+    auto work = [&](bool record) {
+        while (!done) {
+            for (;;) {
+                const std::size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed);
+
+                if (chunk >= chunks) {
+                    break;
+                }
+
+                merge_chunk(chunk);
+            }
+
+            sync.arrive_and_wait();
+
+            // The other threads only touch chunk results, so the totals can be
+            // read here while they already work on the next iteration.
+            if (record && any_grew) {
+                nf.pairs.push_back(std::max(iteration_pairs, nf.pairs.back()));
+            }
+        }
+    };
+
+    for (std::size_t v = 0; v < n; v++) {
+        estimates[v] = estimate(current.data() + v * registers, registers);
+    }
+
+    {
+        std::vector<std::jthread> pool;
+        pool.reserve(threads - 1);
+
+        for (std::size_t t = 1; t < threads; t++) {
+            pool.emplace_back(work, false);
+        }
+
+        work(true);
+    }
+
+    for (std::size_t v = 0; v < n; v++) {
+        nf.eccentricity[node_index[v]] = last_growth[v];
+    }
+
+    return nf;
+}
+
+interval_estimate effective_diameter(const neighbourhood_function& nf, double fraction) {
+    const std::size_t last = nf.pairs.size() - 1;
+    const double error = error_bound_deviations * nf.relative_standard_error;
+    const double total = nf.pairs[last];
+
+    std::vector<double> ratio(nf.pairs.size());
+    std::vector<double> ratio_low(nf.pairs.size());
+    std::vector<double> ratio_high(nf.pairs.size());
+
+    for (std::size_t t = 0; t <= last; t++) {
+        const double pairs = nf.pairs[t];
+
+        ratio[t] = pairs / total;
+        ratio_low[t] = t == last ? 1.0 : pairs * (1.0 - error) / (total * (1.0 + error));
+        ratio_high[t] =
+            t == last ? 1.0 : std::min(1.0, pairs * (1.0 + error) / (total * (1.0 - error)));
+    }
+
+    // The ratio rises more slowly at its low bound, so that bound crosses late.
+    return {.value = crossing(ratio, fraction),
+            .low = crossing(ratio_high, fraction),
+            .high = crossing(ratio_low, fraction)};
+}
+
+interval_estimate average_distance(const neighbourhood_function& nf) {
+    const std::size_t last = nf.pairs.size() - 1;
+    const double error = error_bound_deviations * nf.relative_standard_error;
+    const auto self = static_cast<double>(nf.vertices);
+    const double total = nf.pairs[last];
+
+    if (total <= self) {
+        return {.value = 0.0, .low = 0.0, .high = 0.0};
+    }
+
+    // Sum over t of the share of distinct reachable pairs further apart than t.
+    // The share at t = 0 is exactly one.
+    auto share_beyond = [&](std::size_t t, double pairs, double reachable) {
+        if (t == 0) {
+            return 1.0;
+        }
+
+        if (reachable <= 0.0) {
+            return 0.0;
+        }
+
+        return 1.0 - std::clamp((pairs - self) / reachable, 0.0, 1.0);
+    };
+
+    interval_estimate distance{.value = 0.0, .low = 0.0, .high = 0.0};
+
+    for (std::size_t t = 0; t < last; t++) {
+        const double pairs = nf.pairs[t];
+
+        distance.value += share_beyond(t, pairs, total - self);
+        distance.low += share_beyond(t, pairs * (1.0 + error), total * (1.0 - error) - self);
+        distance.high += share_beyond(t, pairs * (1.0 - error), total * (1.0 + error) - self);
+    }
+
+    return distance;
+}
+
+std::vector<int> approximate_centers(const ogdf::Graph& graph,
+                                     const neighbourhood_function& nf) {
+    std::vector<int> centers;
+
+    std::uint32_t min_eccentricity = std::numeric_limits<std::uint32_t>::max();
+
+    for (ogdf::node v : graph.nodes) {
+        const std::uint32_t eccentricity = nf.eccentricity[v->index()];
+
+        if (eccentricity < min_eccentricity) {
+            min_eccentricity = eccentricity;
+            centers.clear();
+            centers.push_back(v->index());
+        } else if (eccentricity == min_eccentricity) {
+            centers.push_back(v->index());
+        }
+    }
+
+    return centers;
+}
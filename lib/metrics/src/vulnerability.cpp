@@ -0,0 +1,402 @@
+#include "vulnerability.h"
+
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <numeric>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t none = 0xFFFFFFFF;
+
+// Adjacency by node index; every border appears once at each endpoint.
+struct index_graph {
+    std::vector<char> node_present;
+    std::vector<char> edge_present;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> endpoints;
+    std::vector<std::uint32_t> offsets;
+    std::vector<std::uint32_t> neighbours;
+    std::vector<std::uint32_t> edges;
+};
+
+index_graph index_graph_of(const ogdf::Graph& graph) {
+    index_graph g;
+
+    const auto nodes = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+    const auto edges = static_cast<std::size_t>(graph.maxEdgeIndex() + 1);
+
+    g.node_present.assign(nodes, 0);
+    g.edge_present.assign(edges, 0);
+    g.endpoints.assign(edges, {none, none});
+    g.offsets.assign(nodes + 1, 0);
+
+    for (ogdf::node v : graph.nodes) {
+        g.node_present[v->index()] = 1;
+    }
+
+    for (ogdf::edge e : graph.edges) {
+        const auto u = static_cast<std::uint32_t>(e->source()->index());
+        const auto v = static_cast<std::uint32_t>(e->target()->index());
+
+        g.edge_present[e->index()] = 1;
+        g.endpoints[e->index()] = {u, v};
+
+        if (u != v) {
+            g.offsets[u + 1]++;
+            g.offsets[v + 1]++;
+        }
+    }
+
+    std::partial_sum(g.offsets.begin(), g.offsets.end(), g.offsets.begin());
+
+    g.neighbours.resize(g.offsets.back());
+    g.edges.resize(g.offsets.back());
+
+    std::vector<std::uint32_t> next(g.offsets.begin(), g.offsets.end() - 1);
+
+    for (std::uint32_t e = 0; e < edges; e++) {
+        const auto [u, v] = g.endpoints[e];
+
+        if (!g.edge_present[e] || u == v) {
+            continue;
+        }
+
+        g.neighbours[next[u]] = v;
+        g.edges[next[u]++] = e;
+        g.neighbours[next[v]] = u;
+        g.edges[next[v]++] = e;
+    }
+
+    return g;
+}
+
+// The two largest component sizes, so the largest component outside any one
+// component is known without another pass.
+struct largest_two {
+    int first{0};
+    int second{0};
+    std::uint32_t first_component{none};
+
+    void add(int size, std::uint32_t component) {
+        if (size > first) {
+            second = first;
+            first = size;
+            first_component = component;
+        } else if (size > second) {
+            second = size;
+        }
+    }
+
+    int outside(std::uint32_t component) const {
+        return component == first_component ? second : first;
+    }
+};
+
+struct union_find {
+    std::vector<std::uint32_t> parent;
+    std::vector<int> size;
+
+    explicit union_find(std::size_t n) : parent(n), size(n, 1) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    std::uint32_t find(std::uint32_t v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+
+        return v;
+    }
+
+    // Returns the size of the merged set, or zero when already joined.
+    int unite(std::uint32_t a, std::uint32_t b) {
+        a = find(a);
+        b = find(b);
+
+        if (a == b) {
+            return 0;
+        }
+
+        if (size[a] < size[b]) {
+            std::swap(a, b);
+        }
+
+        parent[b] = a;
+        size[a] += size[b];
+
+        return size[a];
+    }
+};
+
+}  // namespace
+
+vulnerability_report analyse_vulnerability(const ogdf::Graph& graph) {
+    const index_graph g = index_graph_of(graph);
+    const std::size_t n = g.node_present.size();
+
+    std::vector<std::uint32_t> discovery(n, none);
+    std::vector<std::uint32_t> low(n, 0);
+    std::vector<std::uint32_t> parent_edge(n, none);
+    std::vector<std::uint32_t> component(n, none);
+    std::vector<int> subtree(n, 1);
+
+    // For every vertex: the pieces its removal cuts off below it in the DFS
+    // tree, their total size and the largest of them.
+    std::vector<int> pieces(n, 0);
+    std::vector<int> separated(n, 0);
+    std::vector<int> largest_piece(n, 0);
+
+    // For every bridge: the size of the side below it.
+    std::vector<int> bridge_below(g.edge_present.size(), 0);
+
+    std::vector<int> component_size;
+    largest_two largest;
+
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> stack;
+    std::uint32_t time = 0;
+
+    for (std::uint32_t root = 0; root < n; root++) {
+        if (!g.node_present[root] || discovery[root] != none) {
+            continue;
+        }
+
+        const auto id = static_cast<std::uint32_t>(component_size.size());
+
+        discovery[root] = low[root] = time++;
+        component[root] = id;
+        stack.emplace_back(root, g.offsets[root]);
+
+        while (!stack.empty()) {
+            auto& [v, next] = stack.back();
+
+            if (next < g.offsets[v + 1]) {
+                const std::uint32_t u = g.neighbours[next];
+                const std::uint32_t e = g.edges[next++];
+
+                if (e == parent_edge[v]) {
+                    continue;
+                }
+
+                if (discovery[u] == none) {
+                    discovery[u] = low[u] = time++;
+                    parent_edge[u] = e;
+                    component[u] = id;
+                    stack.emplace_back(u, g.offsets[u]);
+                } else {
+                    low[v] = std::min(low[v], discovery[u]);
+                }
+
+                continue;
+            }
+
+            const std::uint32_t child = v;
+            stack.pop_back();
+
+            if (stack.empty()) {
+                break;
+            }
+
+            const std::uint32_t p = stack.back().first;
+
+            low[p] = std::min(low[p], low[child]);
+            subtree[p] += subtree[child];
+
+            if (low[child] >= discovery[p]) {
+                pieces[p]++;
+                separated[p] += subtree[child];
+                largest_piece[p] = std::max(largest_piece[p], subtree[child]);
+            }
+
+            if (low[child] > discovery[p]) {
+                bridge_below[parent_edge[child]] = subtree[child];
+            }
+        }
+
+        component_size.push_back(subtree[root]);
+        largest.add(subtree[root], id);
+    }
+
+    const int components = static_cast<int>(component_size.size());
+
+    vulnerability_report report;
+    report.intact = {.components = components, .largest_component = largest.first};
+    report.country_removal.assign(n, report.intact);
+    report.border_removal.assign(g.edge_present.size(), report.intact);
+
+    for (std::uint32_t v = 0; v < n; v++) {
+        if (!g.node_present[v]) {
+            continue;
+        }
+
+        const std::uint32_t c = component[v];
+
+        // The root has no parent side; any other vertex keeps everything that
+        // was not cut off below it attached through its parent.
+        const int rest = component_size[c] - 1 - separated[v];
+        const int total_pieces = pieces[v] + (rest > 0 ? 1 : 0);
+
+        report.country_removal[v] = {
+            .components = components - 1 + total_pieces,
+            .largest_component =
+                std::max({largest.outside(c), largest_piece[v], rest}),
+        };
+
+        if (total_pieces >= 2) {
+            report.articulation_countries.push_back(static_cast<int>(v));
+        }
+    }
+
+    for (std::uint32_t e = 0; e < g.edge_present.size(); e++) {
+        if (!g.edge_present[e] || bridge_below[e] == 0) {
+            continue;
+        }
+
+        const std::uint32_t c = component[g.endpoints[e].first];
+        const int below = bridge_below[e];
+
+        report.border_removal[e] = {
+            .components = components + 1,
+            .largest_component =
+                std::max({largest.outside(c), below, component_size[c] - below}),
+        };
+
+        report.bridge_borders.push_back(static_cast<int>(e));
+    }
+
+    return report;
+}
+
+std::expected<std::vector<removal_effect>, removal_error> removal_sequence(
+    const ogdf::Graph& graph, std::span<const removal> sequence) {
+    const index_graph g = index_graph_of(graph);
+
+    constexpr std::size_t kept = static_cast<std::size_t>(-1);
+
+    // When each country and border is first removed; later repeats are no-ops.
+    std::vector<std::size_t> node_removed(g.node_present.size(), kept);
+    std::vector<std::size_t> edge_removed(g.edge_present.size(), kept);
+
+    for (std::size_t i = 0; i < sequence.size(); i++) {
+        const removal& r = sequence[i];
+
+        if (r.type == removal::kind::country) {
+            if (r.index < 0 || static_cast<std::size_t>(r.index) >= g.node_present.size() ||
+                !g.node_present[r.index]) {
+                return std::unexpected(
+                    removal_error{.error_code = removal_error::code::unknown_country,
+                                  .message = "Country " + std::to_string(r.index) +
+                                             " does not exist",
+                                  .removal_index = i});
+            }
+
+            node_removed[r.index] = std::min(node_removed[r.index], i);
+        } else {
+            if (r.index < 0 || static_cast<std::size_t>(r.index) >= g.edge_present.size() ||
+                !g.edge_present[r.index]) {
+                return std::unexpected(
+                    removal_error{.error_code = removal_error::code::unknown_border,
+                                  .message = "Border " + std::to_string(r.index) +
+                                             " does not exist",
+                                  .removal_index = i});
+            }
+
+            edge_removed[r.index] = std::min(edge_removed[r.index], i);
+        }
+    }
+
+    std::vector<removal_effect> effects(sequence.size());
+
+    if (sequence.empty()) {
+        return effects;
+    }
+
+    // Start from the graph after the whole sequence, where every border whose
+    // endpoints both survive and that was never removed is present.
+    union_find sets(g.node_present.size());
+    int alive = 0;
+    int unions = 0;
+    int largest = 0;
+
+    for (std::uint32_t v = 0; v < g.node_present.size(); v++) {
+        if (g.node_present[v] && node_removed[v] == kept) {
+            alive++;
+            largest = std::max(largest, 1);
+        }
+    }
+
+    auto connect = [&](std::uint32_t e) {
+        const auto [u, v] = g.endpoints[e];
+
+        if (u == v) {
+            return;
+        }
+
+        if (const int merged = sets.unite(u, v); merged > 0) {
+            unions++;
+            largest = std::max(largest, merged);
+        }
+    };
+
+    for (std::uint32_t e = 0; e < g.edge_present.size(); e++) {
+        const auto [u, v] = g.endpoints[e];
+
+        if (g.edge_present[e] && edge_removed[e] == kept && node_removed[u] == kept &&
+            node_removed[v] == kept) {
+            connect(e);
+        }
+    }
+
+    // Undoing removal i turns the state after removal i into the state after
+    // removal i - 1, in which everything first removed at i or later is back.
+    for (std::size_t i = sequence.size(); i-- > 0;) {
+        effects[i] = {.components = alive - unions, .largest_component = largest};
+
+        if (i == 0) {
+            break;
+        }
+
+        const removal& r = sequence[i];
+
+        if (r.type == removal::kind::country) {
+            const auto v = static_cast<std::uint32_t>(r.index);
+
+            if (node_removed[v] != i) {
+                continue;
+            }
+
+            node_removed[v] = kept;
+            alive++;
+            largest = std::max(largest, 1);
+
+            for (std::uint32_t k = g.offsets[v]; k < g.offsets[v + 1]; k++) {
+                if (edge_removed[g.edges[k]] >= i && node_removed[g.neighbours[k]] >= i) {
+                    connect(g.edges[k]);
+                }
+            }
+        } else {
+            const auto e = static_cast<std::uint32_t>(r.index);
+
+            if (edge_removed[e] != i) {
+                continue;
+            }
+
+            edge_removed[e] = kept;
+
+            const auto [u, v] = g.endpoints[e];
+
+            if (node_removed[u] >= i && node_removed[v] >= i) {
+                connect(e);
+            }
+        }
+    }
+
+    return effects;
+}
@@ -0,0 +1,49 @@
+#ifndef REGION_DATA_H
+#define REGION_DATA_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "country_store.h"
+
+// Region caches compiled into the binary. The tables are generated at build
+// time from the region json files (see REGION_DATA_FILES), so a listed region
+// is available without touching the disk or parsing anything at startup.
+namespace region_data {
+
+struct country_record {
+    std::string_view name;
+    std::string_view code;
+    std::string_view capital;
+    // Zero when has_capital_coords is false.
+    double latitude;
+    double longitude;
+    bool has_capital_coords;
+    // Range in region::neighbour_codes, as listed in the source file.
+    std::uint32_t first_code;
+    std::uint32_t code_count;
+    // Range in region::neighbours: indices of the neighbours in this region.
+    std::uint32_t first_neighbour;
+    std::uint32_t neighbour_count;
+};
+
+struct region {
+    std::string_view name;
+    std::span<const country_record> countries;
+    std::span<const std::string_view> neighbour_codes;
+    std::span<const std::uint32_t> neighbours;
+};
+
+// Defined in the generated translation unit.
+std::span<const region> regions();
+
+const region* find(std::string_view name);
+
+// Country order and neighbour order match json_file::read_countries on the
+// source file.
+country_store to_store(const region& embedded);
+
+}  // namespace region_data
+
+#endif  // !REGION_DATA_H
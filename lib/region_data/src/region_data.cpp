@@ -0,0 +1,59 @@
+#include "region_data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "country.h"
+#include "country_store.h"
+
+namespace region_data {
+
+const region* find(std::string_view name) {
+    for (const region& r : regions()) {
+        if (r.name == name) {
+            return &r;
+        }
+    }
+
+    return nullptr;
+}
+
+country_store to_store(const region& embedded) {
+    std::size_t name_bytes = 0;
+
+    for (const country_record& c : embedded.countries) {
+        name_bytes += c.name.size() + c.code.size() + c.capital.size();
+    }
+
+    // Sized so the arena usually needs a single block.
+    country_store store(name_bytes + embedded.countries.size() * 64 + 1024);
+    store.reserve(embedded.countries.size(), embedded.neighbour_codes.size());
+
+    std::vector<std::uint32_t> offsets;
+    offsets.reserve(embedded.countries.size() + 1);
+
+    for (const country_record& c : embedded.countries) {
+        std::optional<capital_coordinates> coords;
+
+        if (c.has_capital_coords) {
+            coords = capital_coordinates{.latitude = c.latitude, .longitude = c.longitude};
+        }
+
+        store.add(c.name, c.code, c.capital, coords,
+                  embedded.neighbour_codes.subspan(c.first_code, c.code_count));
+        offsets.push_back(c.first_neighbour);
+    }
+
+    // The generator linked the same countries, so the neighbour indices are
+    // taken as they are rather than resolved from the codes again.
+    offsets.push_back(static_cast<std::uint32_t>(embedded.neighbours.size()));
+    store.adopt_links(offsets, embedded.neighbours);
+
+    return store;
+}
+
+}  // namespace region_data
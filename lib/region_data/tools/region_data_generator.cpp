@@ -0,0 +1,205 @@
+// Build step: turns region json caches into the constexpr tables behind
+// region_data::regions(). Each input is loaded with json_file::read_countries,
+// so the embedded data is exactly what the runtime loader would produce.
+//
+// Usage: region_data_generator <output.cpp> <region.json>...
+// The region name is the file name without its extension.
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "country_store.h"
+#include "json_file.h"
+
+namespace {
+
+// Octal escapes never run into the following character, unlike \x.
+std::string literal(std::string_view value) {
+    std::string out = "\"";
+
+    for (const char c : value) {
+        const auto byte = static_cast<unsigned char>(c);
+
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (byte < 0x20 || byte >= 0x7f) {
+            char escaped[5];
+            std::snprintf(escaped, sizeof(escaped), "\\%03o", byte);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+
+    out += '"';
+
+    return out;
+}
+
+// Shortest form that reads back to the same double.
+std::string number(double value) {
+    char buffer[32];
+    const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    std::string out(buffer, end);
+
+    if (out.find_first_of(".en") == std::string::npos) {
+        out += ".0";
+    }
+
+    return out;
+}
+
+std::string identifier(std::string_view name) {
+    std::string out = "region_";
+
+    for (const char c : name) {
+        const bool alnum =
+            (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        out += alnum ? c : '_';
+    }
+
+    return out;
+}
+
+void emit_region(std::ostream& out, const std::string& name, const country_store& store) {
+    const std::string id = identifier(name);
+
+    std::vector<std::string> codes;
+    std::vector<std::uint32_t> neighbours;
+
+    out << "constexpr country_record " << id << "_countries[] = {\n";
+
+    for (std::uint32_t i = 0; i < store.size(); i++) {
+        const country_entry& entry = store[i];
+        const country source = store.to_country(i);
+        const auto linked = store.neighbours(i);
+
+        const capital_coordinates coords =
+            entry.capital_coords.value_or(capital_coordinates{.latitude = 0.0, .longitude = 0.0});
+
+        out << "    {" << literal(entry.name) << ", " << literal(entry.code) << ", "
+            << literal(entry.capital) << ", " << number(coords.latitude) << ", "
+            << number(coords.longitude) << ", "
+            << (entry.capital_coords ? "true" : "false") << ", " << codes.size() << ", "
+            << source.neighboring_countries_iso.size() << ", " << neighbours.size() << ", "
+            << linked.size() << "},\n";
+
+        codes.insert(codes.end(), source.neighboring_countries_iso.begin(),
+                     source.neighboring_countries_iso.end());
+        neighbours.insert(neighbours.end(), linked.begin(), linked.end());
+    }
+
+    // Zero-length arrays are ill-formed, so empty tables get one unused slot.
+    if (store.empty()) {
+        out << "    {},\n";
+    }
+
+    out << "};\n\n";
+
+    out << "constexpr std::string_view " << id << "_codes[] = {\n";
+
+    for (const auto& code : codes) {
+        out << "    " << literal(code) << ",\n";
+    }
+
+    if (codes.empty()) {
+        out << "    \"\",\n";
+    }
+
+    out << "};\n\n";
+
+    out << "constexpr std::uint32_t " << id << "_neighbours[] = {";
+
+    for (std::size_t k = 0; k < neighbours.size(); k++) {
+        out << (k % 16 == 0 ? "\n    " : " ") << neighbours[k] << ",";
+    }
+
+    if (neighbours.empty()) {
+        out << "\n    0,";
+    }
+
+    out << "\n};\n\n";
+
+    out << "constexpr std::size_t " << id << "_country_count = " << store.size() << ";\n";
+    out << "constexpr std::size_t " << id << "_code_count = " << codes.size() << ";\n";
+    out << "constexpr std::size_t " << id << "_neighbour_count = " << neighbours.size()
+        << ";\n\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <output.cpp> <region.json>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::ostringstream out;
+
+    out << "// Generated by region_data_generator. Do not edit.\n\n"
+        << "#include <cstddef>\n"
+        << "#include <cstdint>\n"
+        << "#include <span>\n"
+        << "#include <string_view>\n\n"
+        << "#include \"region_data.h\"\n\n"
+        << "namespace region_data {\n\n"
+        << "namespace {\n\n";
+
+    std::vector<std::string> names;
+
+    for (int i = 2; i < argc; i++) {
+        const std::string name = std::filesystem::path(argv[i]).stem().string();
+        auto store = json_file::read_countries(argv[i]);
+
+        if (!store) {
+            std::cerr << "error: " << store.error().message << std::endl
+                      << "Details: " << store.error().details << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        emit_region(out, name, *store);
+        names.push_back(name);
+    }
+
+    out << "constexpr region all_regions[] = {\n";
+
+    for (const auto& name : names) {
+        const std::string id = identifier(name);
+
+        out << "    {" << literal(name) << ",\n"
+            << "     std::span(" << id << "_countries, " << id << "_country_count),\n"
+            << "     std::span(" << id << "_codes, " << id << "_code_count),\n"
+            << "     std::span(" << id << "_neighbours, " << id << "_neighbour_count)},\n";
+    }
+
+    if (names.empty()) {
+        out << "    {},\n";
+    }
+
+    out << "};\n\n"
+        << "}  // namespace\n\n"
+        << "std::span<const region> regions() {\n"
+        << "    return std::span(all_regions, " << names.size() << ");\n"
+        << "}\n\n"
+        << "}  // namespace region_data\n";
+
+    std::ofstream file(argv[1], std::ios::binary);
+    file << out.str();
+
+    if (!file) {
+        std::cerr << "error: failed to write '" << argv[1] << "'" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
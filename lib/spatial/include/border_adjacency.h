@@ -0,0 +1,52 @@
+#ifndef BORDER_ADJACENCY_H
+#define BORDER_ADJACENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "boundary.h"
+#include "country_store.h"
+
+namespace spatial {
+
+struct shared_border {
+    // Indices into the boundaries, first < second.
+    std::uint32_t first;
+    std::uint32_t second;
+    double length_km;
+};
+
+struct border_options {
+    // Segments of two boundaries closer than this, and running almost
+    // parallel, count as shared even when their vertices differ. Zero only
+    // matches segments whose endpoints coincide.
+    double tolerance_km{0.05};
+    // Pairs sharing no more than this are not neighbours. A corner touching
+    // another outline can overlap it by up to the tolerance along collinear
+    // edges, so the default is twice the default tolerance.
+    double min_length_km{0.1};
+    // Zero uses std::thread::hardware_concurrency().
+    std::size_t threads{0};
+};
+
+// Segments are first matched exactly: endpoints are snapped to 1e-7 degrees
+// and hashed, so outlines cut from one shared topology pair up without any
+// geometry. With a tolerance, the remaining segments go into a uniform grid
+// over their bounding boxes and only segments of different boundaries that
+// share a cell are tested against each other. Both stages run on a thread
+// pool. Results are ordered by (first, second).
+std::vector<shared_border> find_shared_borders(std::span<const boundary> boundaries,
+                                               const border_options& options = {});
+
+// One entry per boundary, in order, with the shared borders as neighbours and
+// their lengths as the border lengths. Boundaries have no capital, so the
+// capital name is left empty and its coordinates are the centroid of the
+// largest ring.
+country_store to_store(std::span<const boundary> boundaries,
+                       std::span<const shared_border> borders);
+
+}  // namespace spatial
+
+#endif  // !BORDER_ADJACENCY_H
@@ -0,0 +1,93 @@
+#ifndef CAPITAL_INDEX_H
+#define CAPITAL_INDEX_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "country.h"
+#include "country_store.h"
+
+namespace spatial {
+
+inline constexpr double earth_radius_km = 6371.0;
+
+struct match {
+    std::uint32_t index;
+    double distance_km;
+};
+
+// k-d tree over capitals projected onto the unit sphere. Chord length is
+// monotonic in great-circle distance, so nearest and radius queries run in
+// plain 3D and only the reported distances are converted back to kilometres.
+//
+// Nodes live in one preorder array (the left child directly follows its
+// parent) and points are stored as separate x/y/z arrays in leaf order, so a
+// leaf is a short contiguous scan.
+class capital_index {
+public:
+    capital_index() = default;
+    explicit capital_index(std::span<const capital_coordinates> capitals);
+    // Countries whose capital has no coordinates are left out; matches still
+    // carry store indices.
+    explicit capital_index(const country_store& countries);
+
+    std::size_t size() const;
+
+    // Results are ordered by distance, then by index.
+    std::vector<match> nearest(const capital_coordinates& from, std::size_t k) const;
+    std::vector<match> within(const capital_coordinates& from, double radius_km) const;
+
+    // Batch forms answer the queries in leaf order to keep the tree hot in cache
+    // and return the results in the order of the queries.
+    std::vector<std::vector<match>> nearest(std::span<const capital_coordinates> from,
+                                            std::size_t k) const;
+    std::vector<std::vector<match>> within(std::span<const capital_coordinates> from,
+                                           double radius_km) const;
+
+private:
+    using point = std::array<double, 3>;
+
+    struct node {
+        double split;
+        std::uint32_t begin;
+        std::uint32_t end;
+        // Zero for leaves; the root is never a right child.
+        std::uint32_t right;
+        std::uint8_t axis;
+    };
+
+    static constexpr std::size_t leaf_size = 16;
+
+    void build(std::vector<std::pair<point, std::uint32_t>>& points);
+    std::uint32_t build_node(std::vector<std::pair<point, std::uint32_t>>& points,
+                             std::uint32_t begin, std::uint32_t end);
+
+    std::uint32_t leaf_of(const point& p) const;
+    void scan_leaf(const node& leaf, const point& p, std::span<double> squared) const;
+
+    void search_nearest(const point& p, std::size_t k,
+                        std::vector<std::pair<double, std::uint32_t>>& heap) const;
+    void search_within(const point& p, double squared_chord,
+                       std::vector<std::pair<double, std::uint32_t>>& found) const;
+
+    std::vector<node> nodes_;
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+    std::vector<std::uint32_t> ids_;
+};
+
+double great_circle_km(const capital_coordinates& a, const capital_coordinates& b);
+
+// Reference implementations used to cross-check the index.
+std::vector<match> brute_force_nearest(std::span<const capital_coordinates> capitals,
+                                       const capital_coordinates& from, std::size_t k);
+std::vector<match> brute_force_within(std::span<const capital_coordinates> capitals,
+                                      const capital_coordinates& from, double radius_km);
+
+}  // namespace spatial
+
+#endif  // !CAPITAL_INDEX_H
@@ -0,0 +1,555 @@
+#include "border_adjacency.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numbers>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "capital_index.h"
+#include "country.h"
+#include "country_store.h"
+
+namespace spatial {
+
+namespace {
+
+// Endpoints are compared on a 1e-7 degree lattice, about a centimetre.
+constexpr double snap_per_degree = 1e7;
+
+constexpr double km_per_degree = earth_radius_km * std::numbers::pi / 180.0;
+
+// Segments meeting at more than about ten degrees cross rather than run along
+// each other.
+constexpr double max_parallel_sine = 0.17;
+
+// Exact matching partitions segments by the top bits of their hash.
+constexpr unsigned bucket_bits = 8;
+
+// Grid cells are handed out to threads in chunks.
+constexpr std::size_t cell_chunk = 64;
+
+// Longitude degrees shrink towards the poles; past this latitude the
+// tolerance box is widened as if at this latitude.
+constexpr double max_box_latitude = 89.0;
+
+struct segment {
+    geo_point from;
+    geo_point to;
+    std::uint32_t owner;
+};
+
+// Border length found between two boundaries, keyed by (first << 32 | second).
+struct contribution {
+    std::uint64_t pair;
+    double length_km;
+};
+
+std::uint64_t pair_key(std::uint32_t a, std::uint32_t b) {
+    if (b < a) {
+        std::swap(a, b);
+    }
+
+    return (std::uint64_t{a} << 32) | b;
+}
+
+double length_km(const segment& s) {
+    return great_circle_km({.latitude = s.from.latitude, .longitude = s.from.longitude},
+                           {.latitude = s.to.latitude, .longitude = s.to.longitude});
+}
+
+std::uint64_t snap(const geo_point& p) {
+    const auto latitude = static_cast<std::int32_t>(std::llround(p.latitude * snap_per_degree));
+    const auto longitude = static_cast<std::int32_t>(std::llround(p.longitude * snap_per_degree));
+
+    return (std::uint64_t{static_cast<std::uint32_t>(latitude)} << 32) |
+           static_cast<std::uint32_t>(longitude);
+}
+
+// Snapped endpoints, lower first, so both directions give the same key.
+std::pair<std::uint64_t, std::uint64_t> endpoints(const segment& s) {
+    const std::uint64_t from = snap(s.from);
+    const std::uint64_t to = snap(s.to);
+
+    return {std::min(from, to), std::max(from, to)};
+}
+
+std::uint64_t mix(std::uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    return x ^ (x >> 33);
+}
+
+// Runs task(0) .. task(tasks - 1), each exactly once, on up to `threads`
+// threads. Results written per task stay in task order.
+void parallel_for(std::size_t tasks, std::size_t threads,
+                  const std::function<void(std::size_t)>& task) {
+    threads = std::clamp<std::size_t>(threads != 0 ? threads : std::thread::hardware_concurrency(),
+                                      1, std::max<std::size_t>(tasks, 1));
+
+    std::atomic<std::size_t> next{0};
+
+    auto work = [&] {
+        for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < tasks;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            task(i);
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+
+    for (std::size_t t = 1; t < threads; t++) {
+        pool.emplace_back(work);
+    }
+
+    work();
+}
+
+std::vector<segment> to_segments(std::span<const boundary> boundaries) {
+    std::vector<segment> segments;
+
+    for (std::uint32_t owner = 0; owner < boundaries.size(); owner++) {
+        for (const auto& ring : boundaries[owner].rings) {
+            if (ring.size() < 2) {
+                continue;
+            }
+
+            for (std::size_t i = 0; i + 1 < ring.size(); i++) {
+                if (snap(ring[i]) != snap(ring[i + 1])) {
+                    segments.push_back({.from = ring[i], .to = ring[i + 1], .owner = owner});
+                }
+            }
+
+            if (snap(ring.back()) != snap(ring.front())) {
+                segments.push_back({.from = ring.back(), .to = ring.front(), .owner = owner});
+            }
+        }
+    }
+
+    return segments;
+}
+
+// Segments whose snapped endpoints coincide, in either direction, are shared
+// outright. Marks them in `matched`.
+std::vector<std::vector<contribution>> match_exact(std::span<const segment> segments,
+                                                   std::vector<std::uint8_t>& matched,
+                                                   std::size_t threads) {
+    struct key {
+        std::uint64_t low;
+        std::uint64_t high;
+        std::uint32_t owner;
+        std::uint32_t index;
+
+        auto operator<=>(const key&) const = default;
+    };
+
+    constexpr std::size_t buckets = std::size_t{1} << bucket_bits;
+
+    std::vector<std::uint32_t> bucket_of(segments.size());
+    std::vector<std::size_t> offsets(buckets + 1, 0);
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        const auto [low, high] = endpoints(segments[i]);
+
+        bucket_of[i] = static_cast<std::uint32_t>(mix(low ^ mix(high)) >> (64 - bucket_bits));
+        offsets[bucket_of[i] + 1]++;
+    }
+
+    for (std::size_t b = 0; b < buckets; b++) {
+        offsets[b + 1] += offsets[b];
+    }
+
+    std::vector<key> keys(segments.size());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        const auto [low, high] = endpoints(segments[i]);
+
+        keys[fill[bucket_of[i]]++] = {.low = low,
+                                      .high = high,
+                                      .owner = segments[i].owner,
+                                      .index = static_cast<std::uint32_t>(i)};
+    }
+
+    std::vector<std::vector<contribution>> found(buckets);
+
+    parallel_for(buckets, threads, [&](std::size_t b) {
+        const auto begin = keys.begin() + static_cast<std::ptrdiff_t>(offsets[b]);
+        const auto end = keys.begin() + static_cast<std::ptrdiff_t>(offsets[b + 1]);
+
+        std::sort(begin, end);
+
+        std::vector<std::uint32_t> owners;
+
+        for (auto run = begin; run != end;) {
+            auto run_end = run + 1;
+
+            while (run_end != end && run_end->low == run->low && run_end->high == run->high) {
+                run_end++;
+            }
+
+            // Sorted by owner within the run, so it has two owners or more
+            // exactly when its ends differ.
+            if (run->owner != (run_end - 1)->owner) {
+                const double length = length_km(segments[run->index]);
+
+                owners.clear();
+
+                for (auto k = run; k != run_end; k++) {
+                    matched[k->index] = 1;
+
+                    if (owners.empty() || owners.back() != k->owner) {
+                        owners.push_back(k->owner);
+                    }
+                }
+
+                for (std::size_t a = 0; a < owners.size(); a++) {
+                    for (std::size_t c = a + 1; c < owners.size(); c++) {
+                        found[b].push_back(
+                            {.pair = pair_key(owners[a], owners[c]), .length_km = length});
+                    }
+                }
+            }
+
+            run = run_end;
+        }
+    });
+
+    return found;
+}
+
+struct box {
+    double min_longitude;
+    double min_latitude;
+    double max_longitude;
+    double max_latitude;
+};
+
+// Length along `s` of the stretch where `t` runs almost parallel to it and
+// within the tolerance. Both are projected onto a plane tangent at the middle
+// of `s`, which is accurate at the scale of a tolerance.
+double overlap_km(const segment& s, const segment& t, double tolerance_km) {
+    const double latitude = (s.from.latitude + s.to.latitude) / 2.0 * std::numbers::pi / 180.0;
+    const double kx = km_per_degree * std::cos(latitude);
+    const double ky = km_per_degree;
+
+    auto project = [&](const geo_point& p) {
+        return std::pair{(p.longitude - s.from.longitude) * kx,
+                         (p.latitude - s.from.latitude) * ky};
+    };
+
+    const auto [sx, sy] = project(s.to);
+    const auto [t0x, t0y] = project(t.from);
+    const auto [t1x, t1y] = project(t.to);
+
+    const double s_length = std::hypot(sx, sy);
+    const double t_length = std::hypot(t1x - t0x, t1y - t0y);
+
+    if (s_length == 0.0 || t_length == 0.0) {
+        return 0.0;
+    }
+
+    const double ux = sx / s_length;
+    const double uy = sy / s_length;
+
+    if (std::abs(ux * (t1y - t0y) - uy * (t1x - t0x)) > max_parallel_sine * t_length) {
+        return 0.0;
+    }
+
+    // Position along s and signed offset from its line; the offset is linear
+    // in the position along t.
+    const double a0 = t0x * ux + t0y * uy;
+    const double a1 = t1x * ux + t1y * uy;
+    const double o0 = ux * t0y - uy * t0x;
+    const double o1 = ux * t1y - uy * t1x;
+
+    double low = std::max(0.0, std::min(a0, a1));
+    double high = std::min(s_length, std::max(a0, a1));
+
+    if (a0 != a1) {
+        const double slope = (o1 - o0) / (a1 - a0);
+
+        if (slope != 0.0) {
+            const double at_minus = a0 + (-tolerance_km - o0) / slope;
+            const double at_plus = a0 + (tolerance_km - o0) / slope;
+
+            low = std::max(low, std::min(at_minus, at_plus));
+            high = std::min(high, std::max(at_minus, at_plus));
+        } else if (std::abs(o0) > tolerance_km) {
+            return 0.0;
+        }
+    }
+
+    return std::max(0.0, high - low);
+}
+
+// Segments left unmatched are bucketed into a uniform grid by their bounding
+// boxes, grown by the tolerance. Two segments are tested only if they share a
+// cell, and only in the cell holding the low corner of their boxes' overlap,
+// so each pair is tested once.
+std::vector<std::vector<contribution>> match_nearby(std::span<const segment> segments,
+                                                    const std::vector<std::uint8_t>& matched,
+                                                    double tolerance_km, std::size_t threads) {
+    std::vector<std::uint32_t> open;
+    std::vector<box> boxes;
+
+    const double margin_latitude = tolerance_km / km_per_degree;
+    double extent = 0.0;
+
+    for (std::size_t i = 0; i < segments.size(); i++) {
+        if (matched[i]) {
+            continue;
+        }
+
+        const segment& s = segments[i];
+        const double widest = std::min(
+            max_box_latitude, std::max(std::abs(s.from.latitude), std::abs(s.to.latitude)));
+        const double margin_longitude =
+            margin_latitude / std::cos(widest * std::numbers::pi / 180.0);
+
+        const box b{.min_longitude = std::min(s.from.longitude, s.to.longitude) - margin_longitude,
+                    .min_latitude = std::min(s.from.latitude, s.to.latitude) - margin_latitude,
+                    .max_longitude = std::max(s.from.longitude, s.to.longitude) + margin_longitude,
+                    .max_latitude = std::max(s.from.latitude, s.to.latitude) + margin_latitude};
+
+        open.push_back(static_cast<std::uint32_t>(i));
+        boxes.push_back(b);
+        extent += std::max(b.max_longitude - b.min_longitude, b.max_latitude - b.min_latitude);
+    }
+
+    if (open.empty()) {
+        return {};
+    }
+
+    // About one cell per segment box keeps both the cells a box spans and the
+    // segments per cell small.
+    const double cell = std::max(extent / static_cast<double>(open.size()), 1.0 / snap_per_degree);
+
+    auto cell_coordinate = [cell](double degrees) {
+        return static_cast<std::int32_t>(std::floor(degrees / cell));
+    };
+
+    auto cell_key = [](std::int32_t x, std::int32_t y) {
+        return (std::uint64_t{static_cast<std::uint32_t>(y)} << 32) | static_cast<std::uint32_t>(x);
+    };
+
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> entries;
+
+    for (std::uint32_t k = 0; k < open.size(); k++) {
+        const box& b = boxes[k];
+
+        for (std::int32_t y = cell_coordinate(b.min_latitude); y <= cell_coordinate(b.max_latitude);
+             y++) {
+            for (std::int32_t x = cell_coordinate(b.min_longitude);
+                 x <= cell_coordinate(b.max_longitude); x++) {
+                entries.emplace_back(cell_key(x, y), k);
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+
+    std::vector<std::size_t> cell_starts;
+
+    for (std::size_t e = 0; e < entries.size(); e++) {
+        if (e == 0 || entries[e].first != entries[e - 1].first) {
+            cell_starts.push_back(e);
+        }
+    }
+
+    cell_starts.push_back(entries.size());
+
+    const std::size_t cells = cell_starts.size() - 1;
+    const std::size_t tasks = (cells + cell_chunk - 1) / cell_chunk;
+
+    std::vector<std::vector<contribution>> found(tasks);
+
+    parallel_for(tasks, threads, [&](std::size_t task) {
+        const std::size_t last = std::min(cells, (task + 1) * cell_chunk);
+
+        for (std::size_t c = task * cell_chunk; c < last; c++) {
+            const std::uint64_t here = entries[cell_starts[c]].first;
+
+            for (std::size_t i = cell_starts[c]; i < cell_starts[c + 1]; i++) {
+                const std::uint32_t k = entries[i].second;
+                const segment& s = segments[open[k]];
+
+                for (std::size_t j = i + 1; j < cell_starts[c + 1]; j++) {
+                    const std::uint32_t l = entries[j].second;
+                    const segment& t = segments[open[l]];
+
+                    if (s.owner == t.owner) {
+                        continue;
+                    }
+
+                    const double corner_longitude =
+                        std::max(boxes[k].min_longitude, boxes[l].min_longitude);
+                    const double corner_latitude =
+                        std::max(boxes[k].min_latitude, boxes[l].min_latitude);
+
+                    const bool disjoint =
+                        corner_longitude >
+                            std::min(boxes[k].max_longitude, boxes[l].max_longitude) ||
+                        corner_latitude > std::min(boxes[k].max_latitude, boxes[l].max_latitude);
+
+                    if (disjoint || cell_key(cell_coordinate(corner_longitude),
+                                             cell_coordinate(corner_latitude)) != here) {
+                        continue;
+                    }
+
+                    if (const double length = overlap_km(s, t, tolerance_km); length > 0.0) {
+                        found[task].push_back(
+                            {.pair = pair_key(s.owner, t.owner), .length_km = length});
+                    }
+                }
+            }
+        }
+    });
+
+    return found;
+}
+
+capital_coordinates centroid(const std::vector<std::vector<geo_point>>& rings) {
+    const std::vector<geo_point>* largest = nullptr;
+    double largest_area = -1.0;
+
+    for (const auto& ring : rings) {
+        double area = 0.0;
+
+        for (std::size_t i = 0; i < ring.size(); i++) {
+            const geo_point& p = ring[i];
+            const geo_point& q = ring[(i + 1) % ring.size()];
+
+            area += p.longitude * q.latitude - q.longitude * p.latitude;
+        }
+
+        if (std::abs(area) > largest_area && !ring.empty()) {
+            largest_area = std::abs(area);
+            largest = &ring;
+        }
+    }
+
+    if (largest == nullptr) {
+        return {.latitude = 0.0, .longitude = 0.0};
+    }
+
+    const auto& ring = *largest;
+    double area = 0.0;
+    double longitude = 0.0;
+    double latitude = 0.0;
+
+    for (std::size_t i = 0; i < ring.size(); i++) {
+        const geo_point& p = ring[i];
+        const geo_point& q = ring[(i + 1) % ring.size()];
+        const double cross = p.longitude * q.latitude - q.longitude * p.latitude;
+
+        area += cross;
+        longitude += (p.longitude + q.longitude) * cross;
+        latitude += (p.latitude + q.latitude) * cross;
+    }
+
+    // Degenerate rings (a line or a point) fall back to the vertex mean.
+    if (area == 0.0) {
+        longitude = 0.0;
+        latitude = 0.0;
+
+        for (const geo_point& p : ring) {
+            longitude += p.longitude;
+            latitude += p.latitude;
+        }
+
+        return {.latitude = latitude / static_cast<double>(ring.size()),
+                .longitude = longitude / static_cast<double>(ring.size())};
+    }
+
+    return {.latitude = latitude / (3.0 * area), .longitude = longitude / (3.0 * area)};
+}
+
+}  // namespace
+
+std::vector<shared_border> find_shared_borders(std::span<const boundary> boundaries,
+                                               const border_options& options) {
+    const std::vector<segment> segments = to_segments(boundaries);
+    std::vector<std::uint8_t> matched(segments.size(), 0);
+
+    auto found = match_exact(segments, matched, options.threads);
+
+    if (options.tolerance_km > 0.0) {
+        auto nearby = match_nearby(segments, matched, options.tolerance_km, options.threads);
+        found.insert(found.end(), std::make_move_iterator(nearby.begin()),
+                     std::make_move_iterator(nearby.end()));
+    }
+
+    std::vector<contribution> all;
+
+    for (const auto& task : found) {
+        all.insert(all.end(), task.begin(), task.end());
+    }
+
+    // Stable, so every pair is summed in the same order whatever the threads.
+    std::stable_sort(all.begin(), all.end(),
+                     [](const contribution& a, const contribution& b) { return a.pair < b.pair; });
+
+    std::vector<shared_border> borders;
+
+    for (std::size_t i = 0; i < all.size();) {
+        double length = 0.0;
+        std::size_t j = i;
+
+        for (; j < all.size() && all[j].pair == all[i].pair; j++) {
+            length += all[j].length_km;
+        }
+
+        if (length > options.min_length_km) {
+            borders.push_back({.first = static_cast<std::uint32_t>(all[i].pair >> 32),
+                               .second = static_cast<std::uint32_t>(all[i].pair),
+                               .length_km = length});
+        }
+
+        i = j;
+    }
+
+    return borders;
+}
+
+country_store to_store(std::span<const boundary> boundaries,
+                       std::span<const shared_border> borders) {
+    std::vector<std::vector<std::string_view>> neighbour_codes(boundaries.size());
+    std::vector<std::vector<double>> border_km(boundaries.size());
+    std::size_t name_bytes = 0;
+
+    for (const shared_border& b : borders) {
+        neighbour_codes[b.first].push_back(boundaries[b.second].code);
+        neighbour_codes[b.second].push_back(boundaries[b.first].code);
+        border_km[b.first].push_back(b.length_km);
+        border_km[b.second].push_back(b.length_km);
+    }
+
+    for (const boundary& b : boundaries) {
+        name_bytes += b.name.size() + b.code.size();
+    }
+
+    country_store store(name_bytes + boundaries.size() * 64 + 1024);
+    store.reserve(boundaries.size(), 2 * borders.size());
+
+    for (std::size_t i = 0; i < boundaries.size(); i++) {
+        store.add(boundaries[i].name, boundaries[i].code, "", centroid(boundaries[i].rings),
+                  neighbour_codes[i], border_km[i]);
+    }
+
+    store.link();
+
+    return store;
+}
+
+}  // namespace spatial
@@ -0,0 +1,389 @@
+#include "capital_index.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "country.h"
+#include "country_store.h"
+
+namespace spatial {
+
+namespace {
+
+std::array<double, 3> to_unit(const capital_coordinates& c) {
+    const double latitude = c.latitude * std::numbers::pi / 180.0;
+    const double longitude = c.longitude * std::numbers::pi / 180.0;
+
+    return {std::cos(latitude) * std::cos(longitude), std::cos(latitude) * std::sin(longitude),
+            std::sin(latitude)};
+}
+
+double squared_chord(const std::array<double, 3>& a, const std::array<double, 3>& b) {
+    const double dx = a[0] - b[0];
+    const double dy = a[1] - b[1];
+    const double dz = a[2] - b[2];
+
+    return dx * dx + dy * dy + dz * dz;
+}
+
+double chord_to_km(double squared) {
+    return 2.0 * earth_radius_km * std::asin(std::min(1.0, std::sqrt(squared) / 2.0));
+}
+
+double km_to_squared_chord(double radius_km) {
+    const double half_angle = std::min(radius_km / (2.0 * earth_radius_km), std::numbers::pi / 2);
+    const double chord = 2.0 * std::sin(std::max(0.0, half_angle));
+
+    return chord * chord;
+}
+
+bool closer(const std::pair<double, std::uint32_t>& a, const std::pair<double, std::uint32_t>& b) {
+    return a < b;
+}
+
+std::vector<match> to_matches(std::vector<std::pair<double, std::uint32_t>>& found) {
+    std::sort(found.begin(), found.end(), closer);
+
+    std::vector<match> result;
+    result.reserve(found.size());
+
+    for (const auto& [squared, index] : found) {
+        result.push_back({.index = index, .distance_km = chord_to_km(squared)});
+    }
+
+    return result;
+}
+
+}  // namespace
+
+capital_index::capital_index(std::span<const capital_coordinates> capitals) {
+    std::vector<std::pair<point, std::uint32_t>> points;
+    points.reserve(capitals.size());
+
+    for (std::size_t i = 0; i < capitals.size(); i++) {
+        points.emplace_back(to_unit(capitals[i]), static_cast<std::uint32_t>(i));
+    }
+
+    build(points);
+}
+
+capital_index::capital_index(const country_store& countries) {
+    std::vector<std::pair<point, std::uint32_t>> points;
+    points.reserve(countries.size());
+
+    for (std::uint32_t i = 0; i < countries.size(); i++) {
+        if (const auto& capital = countries[i].capital_coords) {
+            points.emplace_back(to_unit(*capital), i);
+        }
+    }
+
+    build(points);
+}
+
+std::size_t capital_index::size() const { return ids_.size(); }
+
+void capital_index::build(std::vector<std::pair<point, std::uint32_t>>& points) {
+    if (points.empty()) {
+        return;
+    }
+
+    nodes_.reserve(2 * (points.size() / leaf_size + 1));
+    build_node(points, 0, static_cast<std::uint32_t>(points.size()));
+
+    x_.reserve(points.size());
+    y_.reserve(points.size());
+    z_.reserve(points.size());
+    ids_.reserve(points.size());
+
+    for (const auto& [p, id] : points) {
+        x_.push_back(p[0]);
+        y_.push_back(p[1]);
+        z_.push_back(p[2]);
+        ids_.push_back(id);
+    }
+}
+
+std::uint32_t capital_index::build_node(std::vector<std::pair<point, std::uint32_t>>& points,
+                                        std::uint32_t begin, std::uint32_t end) {
+    const auto index = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({.split = 0.0, .begin = begin, .end = end, .right = 0, .axis = 0});
+
+    if (end - begin <= leaf_size) {
+        return index;
+    }
+
+    point low = points[begin].first;
+    point high = low;
+
+    for (std::uint32_t i = begin + 1; i < end; i++) {
+        for (std::size_t a = 0; a < 3; a++) {
+            low[a] = std::min(low[a], points[i].first[a]);
+            high[a] = std::max(high[a], points[i].first[a]);
+        }
+    }
+
+    std::uint8_t axis = 0;
+
+    for (std::uint8_t a = 1; a < 3; a++) {
+        if (high[a] - low[a] > high[axis] - low[axis]) {
+            axis = a;
+        }
+    }
+
+    const std::uint32_t middle = begin + (end - begin) / 2;
+
+    std::nth_element(points.begin() + begin, points.begin() + middle, points.begin() + end,
+                     [axis](const auto& a, const auto& b) { return a.first[axis] < b.first[axis]; });
+
+    const double split = points[middle].first[axis];
+
+    build_node(points, begin, middle);
+    const std::uint32_t right = build_node(points, middle, end);
+
+    nodes_[index].split = split;
+    nodes_[index].axis = axis;
+    nodes_[index].right = right;
+
+    return index;
+}
+
+std::uint32_t capital_index::leaf_of(const point& p) const {
+    std::uint32_t current = 0;
+
+    while (nodes_[current].right != 0) {
+        const node& n = nodes_[current];
+        current = p[n.axis] < n.split ? current + 1 : n.right;
+    }
+
+    return current;
+}
+
+// Distances for a whole leaf are computed in one branch-free pass over the
+// coordinate arrays, which the compiler can vectorise; selection happens after.
+void capital_index::scan_leaf(const node& leaf, const point& p, std::span<double> squared) const {
+    const std::size_t count = leaf.end - leaf.begin;
+    const double* x = x_.data() + leaf.begin;
+    const double* y = y_.data() + leaf.begin;
+    const double* z = z_.data() + leaf.begin;
+
+    for (std::size_t i = 0; i < count; i++) {
+        const double dx = x[i] - p[0];
+        const double dy = y[i] - p[1];
+        const double dz = z[i] - p[2];
+
+        squared[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+void capital_index::search_nearest(const point& p, std::size_t k,
+                                   std::vector<std::pair<double, std::uint32_t>>& heap) const {
+    heap.clear();
+
+    if (nodes_.empty() || k == 0) {
+        return;
+    }
+
+    std::array<std::pair<std::uint32_t, double>, 64> stack;
+    std::size_t top = 0;
+    stack[top++] = {0, 0.0};
+
+    std::array<double, leaf_size> squared;
+
+    while (top > 0) {
+        const auto [current, bound] = stack[--top];
+
+        if (heap.size() == k && bound > heap.front().first) {
+            continue;
+        }
+
+        const node& n = nodes_[current];
+
+        if (n.right == 0) {
+            scan_leaf(n, p, squared);
+
+            for (std::uint32_t i = 0; i < n.end - n.begin; i++) {
+                const std::pair<double, std::uint32_t> candidate{squared[i], ids_[n.begin + i]};
+
+                if (heap.size() < k) {
+                    heap.push_back(candidate);
+                    std::push_heap(heap.begin(), heap.end(), closer);
+                } else if (closer(candidate, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), closer);
+                    heap.back() = candidate;
+                    std::push_heap(heap.begin(), heap.end(), closer);
+                }
+            }
+
+            continue;
+        }
+
+        const double difference = p[n.axis] - n.split;
+        const std::uint32_t near = difference < 0 ? current + 1 : n.right;
+        const std::uint32_t far = difference < 0 ? n.right : current + 1;
+
+        stack[top++] = {far, std::max(bound, difference * difference)};
+        stack[top++] = {near, bound};
+    }
+}
+
+void capital_index::search_within(const point& p, double squared_chord,
+                                  std::vector<std::pair<double, std::uint32_t>>& found) const {
+    found.clear();
+
+    if (nodes_.empty()) {
+        return;
+    }
+
+    std::array<std::pair<std::uint32_t, double>, 64> stack;
+    std::size_t top = 0;
+    stack[top++] = {0, 0.0};
+
+    std::array<double, leaf_size> squared;
+
+    while (top > 0) {
+        const auto [current, bound] = stack[--top];
+
+        if (bound > squared_chord) {
+            continue;
+        }
+
+        const node& n = nodes_[current];
+
+        if (n.right == 0) {
+            scan_leaf(n, p, squared);
+
+            for (std::uint32_t i = 0; i < n.end - n.begin; i++) {
+                if (squared[i] <= squared_chord) {
+                    found.emplace_back(squared[i], ids_[n.begin + i]);
+                }
+            }
+
+            continue;
+        }
+
+        const double difference = p[n.axis] - n.split;
+        const std::uint32_t near = difference < 0 ? current + 1 : n.right;
+        const std::uint32_t far = difference < 0 ? n.right : current + 1;
+
+        stack[top++] = {far, std::max(bound, difference * difference)};
+        stack[top++] = {near, bound};
+    }
+}
+
+std::vector<match> capital_index::nearest(const capital_coordinates& from, std::size_t k) const {
+    std::vector<std::pair<double, std::uint32_t>> heap;
+    search_nearest(to_unit(from), k, heap);
+
+    return to_matches(heap);
+}
+
+std::vector<match> capital_index::within(const capital_coordinates& from,
+                                         double radius_km) const {
+    std::vector<std::pair<double, std::uint32_t>> found;
+    search_within(to_unit(from), km_to_squared_chord(radius_km), found);
+
+    return to_matches(found);
+}
+
+std::vector<std::vector<match>> capital_index::nearest(std::span<const capital_coordinates> from,
+                                                       std::size_t k) const {
+    std::vector<point> points;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> order;
+    points.reserve(from.size());
+    order.reserve(from.size());
+
+    for (std::size_t i = 0; i < from.size(); i++) {
+        points.push_back(to_unit(from[i]));
+        order.emplace_back(nodes_.empty() ? 0 : leaf_of(points.back()),
+                           static_cast<std::uint32_t>(i));
+    }
+
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::vector<match>> results(from.size());
+    std::vector<std::pair<double, std::uint32_t>> heap;
+    heap.reserve(k);
+
+    for (const auto& [leaf, query] : order) {
+        search_nearest(points[query], k, heap);
+        results[query] = to_matches(heap);
+    }
+
+    return results;
+}
+
+std::vector<std::vector<match>> capital_index::within(std::span<const capital_coordinates> from,
+                                                      double radius_km) const {
+    const double squared_chord = km_to_squared_chord(radius_km);
+
+    std::vector<point> points;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> order;
+    points.reserve(from.size());
+    order.reserve(from.size());
+
+    for (std::size_t i = 0; i < from.size(); i++) {
+        points.push_back(to_unit(from[i]));
+        order.emplace_back(nodes_.empty() ? 0 : leaf_of(points.back()),
+                           static_cast<std::uint32_t>(i));
+    }
+
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::vector<match>> results(from.size());
+    std::vector<std::pair<double, std::uint32_t>> found;
+
+    for (const auto& [leaf, query] : order) {
+        search_within(points[query], squared_chord, found);
+        results[query] = to_matches(found);
+    }
+
+    return results;
+}
+
+double great_circle_km(const capital_coordinates& a, const capital_coordinates& b) {
+    return chord_to_km(squared_chord(to_unit(a), to_unit(b)));
+}
+
+std::vector<match> brute_force_nearest(std::span<const capital_coordinates> capitals,
+                                       const capital_coordinates& from, std::size_t k) {
+    const auto p = to_unit(from);
+
+    std::vector<std::pair<double, std::uint32_t>> all;
+    all.reserve(capitals.size());
+
+    for (std::size_t i = 0; i < capitals.size(); i++) {
+        all.emplace_back(squared_chord(to_unit(capitals[i]), p), static_cast<std::uint32_t>(i));
+    }
+
+    std::sort(all.begin(), all.end(), closer);
+    all.resize(std::min(k, all.size()));
+
+    return to_matches(all);
+}
+
+std::vector<match> brute_force_within(std::span<const capital_coordinates> capitals,
+                                      const capital_coordinates& from, double radius_km) {
+    const auto p = to_unit(from);
+    const double limit = km_to_squared_chord(radius_km);
+
+    std::vector<std::pair<double, std::uint32_t>> found;
+
+    for (std::size_t i = 0; i < capitals.size(); i++) {
+        const double squared = squared_chord(to_unit(capitals[i]), p);
+
+        if (squared <= limit) {
+            found.emplace_back(squared, static_cast<std::uint32_t>(i));
+        }
+    }
+
+    return to_matches(found);
+}
+
+}  // namespace spatial
@@ -0,0 +1,9 @@
+#ifndef DISTANCE_MATH_H
+#define DISTANCE_MATH_H
+
+long double rad(const long double& degree);
+
+long double distance(long double lat1, long double long1, long double lat2,
+                     long double long2);
+
+#endif  // !DISTANCE_MATH_H
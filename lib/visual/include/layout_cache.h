@@ -0,0 +1,45 @@
+#ifndef LAYOUT_CACHE_H
+#define LAYOUT_CACHE_H
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include <cstdint>
+#include <expected>
+#include <string>
+
+#include "json_file.h"
+
+// Node positions and edge bends kept in a json file next to the region cache,
+// so exporting an unchanged region skips layout and a changed one starts from
+// where its countries were last drawn. Nodes are matched by a key, the ISO or
+// feature code of their country, and edges by the keys of their endpoints.
+// Labels are only drawn, so two countries may share a name.
+namespace layout_cache {
+
+enum class outcome {
+    // Same node and edge set as the cached layout; positions were copied.
+    reused,
+    // Enough countries were known to refine the previous positions.
+    warm_started,
+    // No usable cache; full planarization layout.
+    computed,
+};
+
+// Warm start needs at least this share of the current countries in the cache.
+inline constexpr double warm_start_min_overlap = 0.5;
+
+// Independent of node and edge order.
+std::uint64_t graph_hash(const ogdf::GraphAttributes& graph_attribute,
+                         const ogdf::NodeArray<std::string>& keys);
+
+// Lays out the graph, reading and refreshing the cache file. A missing or
+// unreadable cache only means a full layout; the error is a failure to write
+// the refreshed cache, after which the layout itself is still in place.
+std::expected<outcome, json_file::error_info> layout(ogdf::GraphAttributes& graph_attribute,
+                                                     const ogdf::NodeArray<std::string>& keys,
+                                                     const std::string& filename);
+
+}  // namespace layout_cache
+
+#endif  // !LAYOUT_CACHE_H
@@ -0,0 +1,49 @@
+#ifndef SVG_WRITER_H
+#define SVG_WRITER_H
+
+#include <ogdf/basic/GraphAttributes.h>
+
+#include <cstddef>
+#include <expected>
+#include <string>
+
+namespace svg {
+
+struct error {
+    enum class code {
+        cannot_open_file,
+        write_failed,
+    };
+
+    code error_code;
+    std::string message;
+    std::string filename;
+    std::string details;
+};
+
+inline error make_error(error::code code, std::string message, std::string filename,
+                        std::string details = "") {
+    return error{.error_code = code,
+                 .message = std::move(message),
+                 .filename = std::move(filename),
+                 .details = std::move(details)};
+}
+
+struct options {
+    // Written gzip-compressed when set, or when the filename ends in ".svgz".
+    bool gzip{false};
+    bool edge_labels{true};
+    // Level of detail: above these sizes edge labels are dropped and nodes
+    // sharing a node-sized grid cell are drawn once.
+    std::size_t edge_label_limit{5000};
+    std::size_t merge_node_limit{10000};
+};
+
+// Streams the drawing straight to the file through a fixed buffer instead of
+// building an XML document first.
+std::expected<void, error> write(const ogdf::GraphAttributes& graph_attribute,
+                                 const std::string& filename, const options& opts = {});
+
+}  // namespace svg
+
+#endif  // !SVG_WRITER_H
@@ -1,20 +1,36 @@
 #ifndef VISUAL_H
 #define VISUAL_H
 
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/basic/Graph_d.h>
+
+#include <expected>
 #include <string>
-#include <unordered_map>
+#include <vector>
+
+#include "country_store.h"
+#include "svg_writer.h"
+
+constexpr long graph_attribute_flags =
+    ogdf::GraphAttributes::nodeGraphics | ogdf::GraphAttributes::edgeGraphics |
+    ogdf::GraphAttributes::nodeLabel | ogdf::GraphAttributes::edgeLabel |
+    ogdf::GraphAttributes::edgeStyle | ogdf::GraphAttributes::edgeArrow |
+    ogdf::GraphAttributes::nodeStyle;
 
-#include "country.h"
+// Returns the node of every country, in store order.
+std::vector<ogdf::node> build_graph(const country_store& countries, ogdf::Graph& graph,
+                                    ogdf::GraphAttributes& graph_attribute);
 
-struct edge_pair {
-    std::string country1;
-    std::string country2;
+void layout_graph(ogdf::GraphAttributes& graph_attribute);
 
-    edge_pair(const std::string& c1, const std::string& c2);
-    bool operator<(const edge_pair& other) const;
-};
+std::expected<void, svg::error> write_graph_svg(const ogdf::GraphAttributes& graph_attribute,
+                                                const std::string& filename,
+                                                const svg::options& opts = {});
 
-void export_graph(std::unordered_map<std::string, country>& countries,
-                  const std::string& filename);
+// With a layout cache file, positions are reused or warm-started from it
+// (see layout_cache.h); without one the graph is laid out from scratch.
+std::expected<void, svg::error> export_graph(const country_store& countries,
+                                             const std::string& filename,
+                                             const std::string& layout_cache_filename = "");
 
 #endif  // VISUAL_H
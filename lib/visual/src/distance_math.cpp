@@ -1,3 +1,4 @@
+#include "distance_math.h"
 
 #include <cmath>
 
@@ -0,0 +1,355 @@
+#include "layout_cache.h"
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <ogdf/energybased/StressMinimization.h>
+#include <ogdf/planarity/PlanarizationLayout.h>
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "json_file.h"
+
+namespace layout_cache {
+
+namespace {
+
+constexpr int format_version = 2;
+
+// Refinement only has to settle the new countries, not untangle the drawing.
+constexpr int warm_start_iterations = 50;
+
+struct cached_edge {
+    std::string source;
+    std::string target;
+    std::vector<std::pair<double, double>> bends;
+};
+
+struct cached_layout {
+    std::uint64_t hash{0};
+    std::unordered_map<std::string, std::pair<double, double>> positions;
+    std::vector<cached_edge> edges;
+};
+
+std::uint64_t fnv1a(std::uint64_t hash, std::string_view bytes) {
+    for (const char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+// Unordered pair of endpoint keys; "\x1f" cannot appear in a country code.
+std::string edge_key(std::string_view a, std::string_view b) {
+    if (b < a) {
+        std::swap(a, b);
+    }
+
+    std::string key(a);
+    key += '\x1f';
+    key += b;
+
+    return key;
+}
+
+std::expected<cached_layout, json_file::error_info> read_cache(const std::string& filename) {
+    auto j = json_file::read(filename);
+
+    if (!j) {
+        return std::unexpected(std::move(j).error());
+    }
+
+    try {
+        if (j->at("version").get<int>() != format_version) {
+            return std::unexpected(json_file::make_error(
+                json_file::error_info::code::failed_parsing, "Unsupported layout cache version",
+                "layout_cache_read", filename));
+        }
+
+        cached_layout cached;
+        cached.hash = j->at("hash").get<std::uint64_t>();
+
+        for (const auto& n : j->at("nodes")) {
+            cached.positions.emplace(n.at("key").get<std::string>(),
+                                     std::pair{n.at("x").get<double>(), n.at("y").get<double>()});
+        }
+
+        for (const auto& e : j->at("edges")) {
+            cached.edges.push_back(
+                {.source = e.at("source").get<std::string>(),
+                 .target = e.at("target").get<std::string>(),
+                 .bends = e.at("bends").get<std::vector<std::pair<double, double>>>()});
+        }
+
+        return cached;
+    } catch (const nlohmann::json::exception& e) {
+        return std::unexpected(json_file::make_error(json_file::error_info::code::failed_parsing,
+                                                     "Malformed layout cache",
+                                                     "layout_cache_read", filename, e.what()));
+    }
+}
+
+std::expected<void, json_file::error_info> write_cache(
+    const ogdf::GraphAttributes& graph_attribute, const ogdf::NodeArray<std::string>& keys,
+    std::uint64_t hash, const std::string& filename) {
+    const ogdf::Graph& graph = graph_attribute.constGraph();
+
+    nlohmann::json nodes = nlohmann::json::array();
+
+    for (ogdf::node v : graph.nodes) {
+        nodes.push_back({{"key", keys[v]},
+                         {"x", graph_attribute.x(v)},
+                         {"y", graph_attribute.y(v)}});
+    }
+
+    nlohmann::json edges = nlohmann::json::array();
+
+    for (ogdf::edge e : graph.edges) {
+        nlohmann::json bends = nlohmann::json::array();
+
+        for (const ogdf::DPoint& p : graph_attribute.bends(e)) {
+            bends.push_back({p.m_x, p.m_y});
+        }
+
+        edges.push_back({{"source", keys[e->source()]},
+                         {"target", keys[e->target()]},
+                         {"bends", std::move(bends)}});
+    }
+
+    return json_file::write(filename, {{"version", format_version},
+                                       {"hash", hash},
+                                       {"nodes", std::move(nodes)},
+                                       {"edges", std::move(edges)}});
+}
+
+// Copies cached positions onto the nodes it knows and returns how many it knew.
+std::size_t place_known(ogdf::GraphAttributes& graph_attribute,
+                        const ogdf::NodeArray<std::string>& keys, const cached_layout& cached,
+                        ogdf::NodeArray<bool>& known) {
+    std::size_t count = 0;
+
+    for (ogdf::node v : graph_attribute.constGraph().nodes) {
+        const auto it = cached.positions.find(keys[v]);
+
+        if (it != cached.positions.end()) {
+            graph_attribute.x(v) = it->second.first;
+            graph_attribute.y(v) = it->second.second;
+            known[v] = true;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+// Copies cached bends onto matching edges, reversing them when the edge now
+// points the other way. Returns false if some edge is not in the cache.
+bool place_bends(ogdf::GraphAttributes& graph_attribute, const ogdf::NodeArray<std::string>& keys,
+                 const cached_layout& cached) {
+    std::unordered_map<std::string, const cached_edge*> by_key;
+
+    for (const auto& e : cached.edges) {
+        by_key.emplace(edge_key(e.source, e.target), &e);
+    }
+
+    bool complete = true;
+
+    for (ogdf::edge e : graph_attribute.constGraph().edges) {
+        const std::string& source = keys[e->source()];
+        const auto it = by_key.find(edge_key(source, keys[e->target()]));
+
+        ogdf::DPolyline& bends = graph_attribute.bends(e);
+        bends.clear();
+
+        if (it == by_key.end()) {
+            complete = false;
+            continue;
+        }
+
+        auto points = it->second->bends;
+
+        if (it->second->source != source) {
+            std::reverse(points.begin(), points.end());
+        }
+
+        for (const auto& [x, y] : points) {
+            bends.pushBack(ogdf::DPoint(x, y));
+        }
+    }
+
+    return complete;
+}
+
+double mean_edge_length(const ogdf::GraphAttributes& graph_attribute,
+                        const ogdf::NodeArray<bool>& known) {
+    double total = 0.0;
+    std::size_t count = 0;
+
+    for (ogdf::edge e : graph_attribute.constGraph().edges) {
+        if (known[e->source()] && known[e->target()] && e->source() != e->target()) {
+            total += std::hypot(graph_attribute.x(e->source()) - graph_attribute.x(e->target()),
+                                graph_attribute.y(e->source()) - graph_attribute.y(e->target()));
+            count++;
+        }
+    }
+
+    return count == 0 ? 0.0 : total / static_cast<double>(count);
+}
+
+// New countries start at the centre of their placed neighbours, nudged aside
+// so they do not sit exactly on top of one; countries with no placed
+// neighbour are lined up below the existing drawing.
+void place_new(ogdf::GraphAttributes& graph_attribute, const ogdf::NodeArray<bool>& known) {
+    const ogdf::Graph& graph = graph_attribute.constGraph();
+
+    double bottom = 0.0;
+    double left = 0.0;
+    bool any = false;
+
+    for (ogdf::node v : graph.nodes) {
+        if (known[v]) {
+            bottom = any ? std::max(bottom, graph_attribute.y(v)) : graph_attribute.y(v);
+            left = any ? std::min(left, graph_attribute.x(v)) : graph_attribute.x(v);
+            any = true;
+        }
+    }
+
+    std::size_t lined_up = 0;
+
+    for (ogdf::node v : graph.nodes) {
+        if (known[v]) {
+            continue;
+        }
+
+        double x = 0.0;
+        double y = 0.0;
+        std::size_t neighbours = 0;
+
+        for (ogdf::adjEntry adj = v->firstAdj(); adj; adj = adj->succ()) {
+            const ogdf::node u = adj->twinNode();
+
+            if (known[u]) {
+                x += graph_attribute.x(u);
+                y += graph_attribute.y(u);
+                neighbours++;
+            }
+        }
+
+        if (neighbours > 0) {
+            graph_attribute.x(v) = x / static_cast<double>(neighbours) + graph_attribute.width(v);
+            graph_attribute.y(v) = y / static_cast<double>(neighbours) + graph_attribute.height(v);
+        } else {
+            graph_attribute.x(v) =
+                left + static_cast<double>(lined_up++) * 2.0 * graph_attribute.width(v);
+            graph_attribute.y(v) = bottom + 2.0 * graph_attribute.height(v);
+        }
+    }
+}
+
+}  // namespace
+
+std::uint64_t graph_hash(const ogdf::GraphAttributes& graph_attribute,
+                         const ogdf::NodeArray<std::string>& keys) {
+    const ogdf::Graph& graph = graph_attribute.constGraph();
+
+    std::vector<std::string> nodes;
+    nodes.reserve(graph.numberOfNodes());
+
+    for (ogdf::node v : graph.nodes) {
+        nodes.push_back(keys[v]);
+    }
+
+    std::vector<std::string> edges;
+    edges.reserve(graph.numberOfEdges());
+
+    for (ogdf::edge e : graph.edges) {
+        edges.push_back(edge_key(keys[e->source()], keys[e->target()]));
+    }
+
+    std::sort(nodes.begin(), nodes.end());
+    std::sort(edges.begin(), edges.end());
+
+    std::uint64_t hash = fnv1a(0xcbf29ce484222325ULL, std::to_string(format_version));
+
+    for (const auto* list : {&nodes, &edges}) {
+        hash = fnv1a(hash, std::to_string(list->size()));
+
+        for (const auto& item : *list) {
+            hash = fnv1a(hash, item);
+            hash = fnv1a(hash, std::string_view("\x1e", 1));
+        }
+    }
+
+    return hash;
+}
+
+std::expected<outcome, json_file::error_info> layout(ogdf::GraphAttributes& graph_attribute,
+                                                     const ogdf::NodeArray<std::string>& keys,
+                                                     const std::string& filename) {
+    const ogdf::Graph& graph = graph_attribute.constGraph();
+    const std::uint64_t hash = graph_hash(graph_attribute, keys);
+
+    auto cached = std::filesystem::exists(filename)
+                      ? read_cache(filename)
+                      : std::expected<cached_layout, json_file::error_info>(cached_layout{});
+
+    outcome result = outcome::computed;
+
+    if (cached && !cached->positions.empty()) {
+        ogdf::NodeArray<bool> known(graph, false);
+        const std::size_t placed = place_known(graph_attribute, keys, *cached, known);
+        const bool complete_edges = place_bends(graph_attribute, keys, *cached);
+
+        if (cached->hash == hash && placed == static_cast<std::size_t>(graph.numberOfNodes()) &&
+            complete_edges) {
+            return outcome::reused;
+        }
+
+        if (placed > 0 && static_cast<double>(placed) >=
+                              warm_start_min_overlap * graph.numberOfNodes()) {
+            const double edge_length = mean_edge_length(graph_attribute, known);
+
+            place_new(graph_attribute, known);
+            graph_attribute.clearAllBends();
+
+            ogdf::StressMinimization stress;
+            stress.hasInitialLayout(true);
+            stress.setIterations(warm_start_iterations);
+
+            if (edge_length > 0.0) {
+                stress.setEdgeCosts(edge_length);
+            }
+
+            stress.call(graph_attribute);
+
+            result = outcome::warm_started;
+        }
+    }
+
+    if (result == outcome::computed) {
+        graph_attribute.clearAllBends();
+
+        ogdf::PlanarizationLayout planar_layout;
+        planar_layout.call(graph_attribute);
+    }
+
+    if (auto written = write_cache(graph_attribute, keys, hash, filename); !written) {
+        return std::unexpected(std::move(written).error());
+    }
+
+    return result;
+}
+
+}  // namespace layout_cache
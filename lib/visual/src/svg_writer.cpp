@@ -0,0 +1,438 @@
+#include "svg_writer.h"
+
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace svg {
+
+namespace {
+
+class output {
+public:
+    output(const std::string& filename, bool gzip) {
+        if (gzip) {
+            gz_ = gzopen(filename.c_str(), "wb6");
+        } else {
+            file_ = std::fopen(filename.c_str(), "wb");
+        }
+    }
+
+    ~output() { close(); }
+
+    output(const output&) = delete;
+    output& operator=(const output&) = delete;
+
+    bool is_open() const { return file_ != nullptr || gz_ != nullptr; }
+
+    bool failed() const { return failed_; }
+
+    void write(std::string_view text) {
+        if (text.size() > buffer_.size() - used_) {
+            flush();
+
+            if (text.size() > buffer_.size()) {
+                write_through(text.data(), text.size());
+                return;
+            }
+        }
+
+        std::memcpy(buffer_.data() + used_, text.data(), text.size());
+        used_ += text.size();
+    }
+
+    // NaN or infinite positions from a degenerate layout are drawn at 0 rather
+    // than written as "nan" or "inf", which no SVG viewer accepts.
+    void number(double value) {
+        if (!std::isfinite(value)) {
+            value = 0.0;
+        }
+
+        if (buffer_.size() - used_ < short_number) {
+            flush();
+        }
+
+        const auto result = std::to_chars(buffer_.data() + used_, buffer_.data() + buffer_.size(),
+                                          value, std::chars_format::fixed, 2);
+
+        if (result.ec == std::errc{}) {
+            used_ = static_cast<std::size_t>(result.ptr - buffer_.data());
+            return;
+        }
+
+        // Fixed notation spells out every integer digit, so a huge magnitude
+        // can outgrow the space reserved for coordinates.
+        std::array<char, longest_number> digits;
+        const auto wide =
+            std::to_chars(digits.data(), digits.data() + digits.size(), value,
+                          std::chars_format::fixed, 2);
+
+        if (wide.ec != std::errc{}) {
+            failed_ = true;
+            return;
+        }
+
+        write(std::string_view(digits.data(), wide.ptr));
+    }
+
+    void escaped(std::string_view text) {
+        std::size_t start = 0;
+
+        for (std::size_t i = 0; i < text.size(); i++) {
+            std::string_view entity;
+
+            switch (text[i]) {
+                case '&':
+                    entity = "&amp;";
+                    break;
+                case '<':
+                    entity = "&lt;";
+                    break;
+                case '>':
+                    entity = "&gt;";
+                    break;
+                case '"':
+                    entity = "&quot;";
+                    break;
+                default:
+                    continue;
+            }
+
+            write(text.substr(start, i - start));
+            write(entity);
+            start = i + 1;
+        }
+
+        write(text.substr(start));
+    }
+
+    void flush() {
+        write_through(buffer_.data(), used_);
+        used_ = 0;
+    }
+
+    bool close() {
+        if (!is_open()) {
+            return !failed_;
+        }
+
+        flush();
+
+        if (gz_ != nullptr) {
+            failed_ = gzclose(gz_) != Z_OK || failed_;
+            gz_ = nullptr;
+        } else {
+            failed_ = std::fclose(file_) != 0 || failed_;
+            file_ = nullptr;
+        }
+
+        return !failed_;
+    }
+
+private:
+    // Room for any coordinate of a sane drawing, and for the longest double in
+    // fixed notation with two decimals: sign, 309 digits, point and decimals.
+    static constexpr std::size_t short_number = 32;
+    static constexpr std::size_t longest_number = std::numeric_limits<double>::max_exponent10 + 6;
+
+    void write_through(const char* data, std::size_t size) {
+        if (size == 0 || failed_) {
+            return;
+        }
+
+        if (gz_ != nullptr) {
+            failed_ = gzwrite(gz_, data, static_cast<unsigned>(size)) != static_cast<int>(size);
+        } else {
+            failed_ = std::fwrite(data, 1, size, file_) != size;
+        }
+    }
+
+    std::FILE* file_{nullptr};
+    gzFile gz_{nullptr};
+    std::vector<char> buffer_ = std::vector<char>(1 << 16);
+    std::size_t used_{0};
+    bool failed_{false};
+};
+
+struct point {
+    double x;
+    double y;
+};
+
+std::uint64_t pair_key(std::uint32_t a, std::uint32_t b) {
+    if (a > b) {
+        std::swap(a, b);
+    }
+
+    return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+
+// Maps every node to the node drawn in its place. Without merging that is the
+// node itself; with merging the first node to land in a grid cell the size of
+// a node represents every other node in that cell.
+ogdf::NodeArray<ogdf::node> representatives(const ogdf::GraphAttributes& ga, bool merge,
+                                            ogdf::NodeArray<int>& merged) {
+    const ogdf::Graph& graph = ga.constGraph();
+    ogdf::NodeArray<ogdf::node> representative(graph);
+
+    if (!merge) {
+        for (ogdf::node v : graph.nodes) {
+            representative[v] = v;
+        }
+
+        return representative;
+    }
+
+    double cell = 1.0;
+
+    for (ogdf::node v : graph.nodes) {
+        cell = std::max({cell, ga.width(v), ga.height(v)});
+    }
+
+    std::unordered_map<std::uint64_t, ogdf::node> cells;
+    cells.reserve(static_cast<std::size_t>(graph.numberOfNodes()));
+
+    for (ogdf::node v : graph.nodes) {
+        const auto cx = static_cast<std::int32_t>(std::floor(ga.x(v) / cell));
+        const auto cy = static_cast<std::int32_t>(std::floor(ga.y(v) / cell));
+        const std::uint64_t key =
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+            static_cast<std::uint32_t>(cy);
+
+        const auto [it, inserted] = cells.try_emplace(key, v);
+        representative[v] = it->second;
+        merged[it->second]++;
+    }
+
+    return representative;
+}
+
+void write_node(output& out, const ogdf::GraphAttributes& ga, ogdf::node v) {
+    const double w = ga.width(v);
+    const double h = ga.height(v);
+
+    switch (ga.shape(v)) {
+        case ogdf::Shape::Ellipse:
+            out.write("<ellipse cx=\"");
+            out.number(ga.x(v));
+            out.write("\" cy=\"");
+            out.number(ga.y(v));
+            out.write("\" rx=\"");
+            out.number(w / 2);
+            out.write("\" ry=\"");
+            out.number(h / 2);
+            out.write("\"/>\n");
+            return;
+        default:
+            out.write("<rect x=\"");
+            out.number(ga.x(v) - w / 2);
+            out.write("\" y=\"");
+            out.number(ga.y(v) - h / 2);
+            out.write("\" width=\"");
+            out.number(w);
+            out.write("\" height=\"");
+            out.number(h);
+            out.write(ga.shape(v) == ogdf::Shape::RoundedRect ? "\" rx=\"10\"/>\n" : "\"/>\n");
+            return;
+    }
+}
+
+void write_text(output& out, double x, double y, std::string_view text) {
+    out.write("<text x=\"");
+    out.number(x);
+    out.write("\" y=\"");
+    out.number(y);
+    out.write("\">");
+    out.escaped(text);
+    out.write("</text>\n");
+}
+
+}  // namespace
+
+std::expected<void, error> write(const ogdf::GraphAttributes& ga, const std::string& filename,
+                                 const options& opts) {
+    const ogdf::Graph& graph = ga.constGraph();
+
+    const bool gzip = opts.gzip || filename.ends_with(".svgz");
+    const bool merge = static_cast<std::size_t>(graph.numberOfNodes()) > opts.merge_node_limit;
+    const bool edge_labels = opts.edge_labels && static_cast<std::size_t>(graph.numberOfEdges()) <=
+                                                     opts.edge_label_limit;
+
+    output out(filename, gzip);
+
+    if (!out.is_open()) {
+        return std::unexpected(
+            make_error(error::code::cannot_open_file,
+                       "Failed to open file '" + filename + "' for writing", filename,
+                       "System error: " + std::string(std::strerror(errno))));
+    }
+
+    ogdf::NodeArray<int> merged(graph, 0);
+    const ogdf::NodeArray<ogdf::node> representative = representatives(ga, merge, merged);
+
+    double min_x = std::numeric_limits<double>::max();
+    double min_y = std::numeric_limits<double>::max();
+    double max_x = std::numeric_limits<double>::lowest();
+    double max_y = std::numeric_limits<double>::lowest();
+
+    for (ogdf::node v : graph.nodes) {
+        min_x = std::min(min_x, ga.x(v) - ga.width(v) / 2);
+        min_y = std::min(min_y, ga.y(v) - ga.height(v) / 2);
+        max_x = std::max(max_x, ga.x(v) + ga.width(v) / 2);
+        max_y = std::max(max_y, ga.y(v) + ga.height(v) / 2);
+    }
+
+    for (ogdf::edge e : graph.edges) {
+        for (const auto& bend : ga.bends(e)) {
+            min_x = std::min(min_x, bend.m_x);
+            min_y = std::min(min_y, bend.m_y);
+            max_x = std::max(max_x, bend.m_x);
+            max_y = std::max(max_y, bend.m_y);
+        }
+    }
+
+    if (graph.numberOfNodes() == 0) {
+        min_x = min_y = max_x = max_y = 0.0;
+    }
+
+    constexpr double margin = 10.0;
+
+    out.write(
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" viewBox=\"");
+    out.number(min_x - margin);
+    out.write(" ");
+    out.number(min_y - margin);
+    out.write(" ");
+    out.number(max_x - min_x + 2 * margin);
+    out.write(" ");
+    out.number(max_y - min_y + 2 * margin);
+    out.write("\" width=\"");
+    out.number(max_x - min_x + 2 * margin);
+    out.write("\" height=\"");
+    out.number(max_y - min_y + 2 * margin);
+    out.write("\">\n");
+
+    std::unordered_set<std::uint64_t> drawn_edges;
+    std::vector<point> path;
+    std::vector<std::pair<point, ogdf::edge>> labels;
+
+    out.write("<g fill=\"none\" stroke=\"#000000\" stroke-linejoin=\"round\">\n");
+
+    for (ogdf::edge e : graph.edges) {
+        const ogdf::node source = representative[e->source()];
+        const ogdf::node target = representative[e->target()];
+
+        if (merge &&
+            (source == target ||
+             !drawn_edges.insert(pair_key(source->index(), target->index())).second)) {
+            continue;
+        }
+
+        path.clear();
+        path.push_back({ga.x(source), ga.y(source)});
+
+        if (!merge) {
+            for (const auto& bend : ga.bends(e)) {
+                path.push_back({bend.m_x, bend.m_y});
+            }
+        }
+
+        path.push_back({ga.x(target), ga.y(target)});
+
+        out.write("<path d=\"M");
+
+        for (std::size_t i = 0; i < path.size(); i++) {
+            out.write(i == 0 ? "" : " L");
+            out.number(path[i].x);
+            out.write(" ");
+            out.number(path[i].y);
+        }
+
+        out.write("\" stroke-width=\"");
+        out.number(ga.has(ogdf::GraphAttributes::edgeStyle) ? ga.strokeWidth(e) : 1.0);
+        out.write("\"/>\n");
+
+        if (edge_labels && ga.has(ogdf::GraphAttributes::edgeLabel) && !ga.label(e).empty()) {
+            const std::size_t segment = (path.size() - 2) / 2;
+            labels.emplace_back(point{(path[segment].x + path[segment + 1].x) / 2,
+                                      (path[segment].y + path[segment + 1].y) / 2},
+                                e);
+        }
+    }
+
+    out.write("</g>\n");
+
+    if (!labels.empty()) {
+        out.write(
+            "<g font-family=\"Arial\" font-size=\"12\" text-anchor=\"middle\" "
+            "fill=\"#000000\">\n");
+
+        for (const auto& [position, e] : labels) {
+            write_text(out, position.x, position.y, ga.label(e));
+        }
+
+        out.write("</g>\n");
+    }
+
+    out.write("<g fill=\"#FFFFFF\" stroke=\"#000000\" stroke-width=\"1\">\n");
+
+    for (ogdf::node v : graph.nodes) {
+        if (representative[v] == v) {
+            write_node(out, ga, v);
+        }
+    }
+
+    out.write("</g>\n");
+
+    if (ga.has(ogdf::GraphAttributes::nodeLabel)) {
+        out.write(
+            "<g font-family=\"Arial\" font-size=\"14\" text-anchor=\"middle\" "
+            "dominant-baseline=\"central\" fill=\"#000000\">\n");
+
+        std::string label;
+
+        for (ogdf::node v : graph.nodes) {
+            if (representative[v] != v) {
+                continue;
+            }
+
+            label = ga.label(v);
+
+            if (merged[v] > 1) {
+                label += " (+" + std::to_string(merged[v] - 1) + ")";
+            }
+
+            write_text(out, ga.x(v), ga.y(v), label);
+        }
+
+        out.write("</g>\n");
+    }
+
+    out.write("</svg>\n");
+
+    if (!out.close()) {
+        return std::unexpected(make_error(error::code::write_failed,
+                                          "Failed to write to file '" + filename + "'", filename,
+                                          "Stream failure during write operation"));
+    }
+
+    return {};
+}
+
+}  // namespace svg
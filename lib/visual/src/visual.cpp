@@ -3,55 +3,36 @@
 #include <ogdf/basic/Graph.h>
 #include <ogdf/basic/GraphAttributes.h>
 #include <ogdf/basic/Graph_d.h>
-#include <ogdf/fileformats/GraphIO.h>
 #include <ogdf/planarity/PlanarizationLayout.h>
 
-#include <set>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <iostream>
 #include <string>
+#include <utility>
+#include <vector>
 
-#include "distance_math.cpp"
+#include "distance_math.h"
+#include "layout_cache.h"
 #include "metrics.h"
+#include "svg_writer.h"
 
 using namespace ogdf;
 
-edge_pair::edge_pair(const std::string& c1, const std::string& c2) {
-    if (c1 < c2) {
-        country1 = c1;
-        country2 = c2;
-    } else {
-        country1 = c2;
-        country2 = c1;
-    }
-}
-
-bool edge_pair::operator<(const edge_pair& other) const {
-    if (country1 != other.country1) {
-        return country1 < other.country1;
-    }
-
-    return country2 < other.country2;
-}
-
-void export_graph(std::unordered_map<std::string, country>& countries,
-                  const std::string& filename) {
-    Graph graph;
-
-    GraphAttributes graph_attribute(
-        graph, GraphAttributes::nodeGraphics | GraphAttributes::edgeGraphics |
-                   GraphAttributes::nodeLabel | GraphAttributes::edgeLabel |
-                   GraphAttributes::edgeStyle | GraphAttributes::edgeArrow |
-                   GraphAttributes::nodeStyle
-
-    );
-
+std::vector<node> build_graph(const country_store& countries, Graph& graph,
+                              GraphAttributes& graph_attribute) {
     graph_attribute.directed() = false;
 
-    std::unordered_map<std::string, node> name_to_node;
+    std::vector<node> nodes;
+    nodes.reserve(countries.size());
 
-    for (const auto& [_, country] : countries) {
+    for (const auto& country : countries.entries()) {
         node v = graph.newNode();
 
-        name_to_node[country.name] = v;
+        nodes.push_back(v);
 
         graph_attribute.label(v) = country.name;
 
@@ -61,44 +42,97 @@ void export_graph(std::unordered_map<std::string, country>& countries,
         graph_attribute.shape(v) = Shape::RoundedRect;
     }
 
-    std::set<edge_pair> added_edges;
+    struct border {
+        std::uint32_t u;
+        std::uint32_t v;
+        double km;
+    };
+
+    std::vector<border> borders;
 
-    for (const auto& [_, country] : countries) {
-        for (const auto& neighbour_iso : country.neighboring_countries_iso) {
-            auto neighbour = countries[neighbour_iso];
+    for (std::uint32_t i = 0; i < countries.size(); i++) {
+        const auto neighbours = countries.neighbours(i);
+        const auto border_km = countries.border_km(i);
 
-            if (name_to_node.contains(neighbour.name)) {
-                edge_pair edge_pair(country.name, neighbour.name);
+        for (std::size_t k = 0; k < neighbours.size(); k++) {
+            if (neighbours[k] != i) {
+                borders.push_back({.u = std::min(i, neighbours[k]),
+                                   .v = std::max(i, neighbours[k]),
+                                   .km = border_km.empty() ? std::nan("") : border_km[k]});
+            }
+        }
+    }
 
-                if (added_edges.insert(edge_pair).second) {
-                    auto v1 = name_to_node[country.name];
-                    auto v2 = name_to_node[neighbour.name];
+    const auto pair_of = [](const border& b) { return std::pair(b.u, b.v); };
 
-                    edge e = graph.newEdge(v1, v2);
+    std::ranges::sort(borders, {}, pair_of);
+    borders.erase(std::ranges::unique(borders, {}, pair_of).begin(), borders.end());
 
-                    graph_attribute.strokeWidth(e) = 2.0;
-                    graph_attribute.arrowType(e) = EdgeArrow::None;
+    for (const auto& [u, v, km] : borders) {
+        const auto& country = countries[u];
+        const auto& neighbour = countries[v];
 
-                    const std::string name = std::to_string(distance(
-                        country.capital_coords.latitude, country.capital_coords.longitude,
-                        neighbour.capital_coords.latitude,
-                        neighbour.capital_coords.longitude));
+        edge e = graph.newEdge(nodes[u], nodes[v]);
 
-                    graph_attribute.label(e) = name;
-                }
-            }
+        graph_attribute.strokeWidth(e) = 2.0;
+        graph_attribute.arrowType(e) = EdgeArrow::None;
+
+        // Outlines give the border's own length; otherwise the label is the
+        // distance between the capitals.
+        if (!std::isnan(km)) {
+            graph_attribute.label(e) = std::to_string(km);
+        } else if (country.capital_coords && neighbour.capital_coords) {
+            graph_attribute.label(e) = std::to_string(
+                distance(country.capital_coords->latitude, country.capital_coords->longitude,
+                         neighbour.capital_coords->latitude, neighbour.capital_coords->longitude));
         }
     }
 
+    return nodes;
+}
+
+void layout_graph(GraphAttributes& graph_attribute) {
     PlanarizationLayout planar_layout;
 
     planar_layout.call(graph_attribute);
+}
+
+std::expected<void, svg::error> write_graph_svg(const GraphAttributes& graph_attribute,
+                                                const std::string& filename,
+                                                const svg::options& opts) {
+    return svg::write(graph_attribute, filename, opts);
+}
+
+std::expected<void, svg::error> export_graph(const country_store& countries,
+                                             const std::string& filename,
+                                             const std::string& layout_cache_filename) {
+    Graph graph;
+
+    GraphAttributes graph_attribute(graph, graph_attribute_flags);
+
+    const std::vector<node> nodes = build_graph(countries, graph, graph_attribute);
+
+    if (layout_cache_filename.empty()) {
+        layout_graph(graph_attribute);
+    } else {
+        NodeArray<std::string> keys(graph);
+
+        for (std::uint32_t i = 0; i < countries.size(); i++) {
+            keys[nodes[i]] = countries[i].code;
+        }
+
+        if (auto cached = layout_cache::layout(graph_attribute, keys, layout_cache_filename);
+            !cached) {
+            // The layout is in place; only the cache for the next run is missing.
+            std::cerr << "Warning: " << cached.error().message << std::endl;
+        }
+    }
 
-    metrics* m = calculate_metrics(graph, graph_attribute);
+    metrics* m = calculate_metrics(countries, graph, graph_attribute);
 
     print_metrics(m, graph_attribute);
 
     delete_metrics(m);
 
-    GraphIO::write(graph_attribute, filename, GraphIO::drawSVG);
+    return write_graph_svg(graph_attribute, filename);
 }
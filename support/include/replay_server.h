@@ -0,0 +1,102 @@
+#ifndef REPLAY_SERVER_H
+#define REPLAY_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace replay {
+
+struct response {
+    int status{200};
+    std::string body;
+    std::vector<std::pair<std::string, std::string>> headers{};
+};
+
+using fixtures = std::unordered_map<std::string, response>;
+
+// Query parameters are sorted and the api key is dropped, so a recording made
+// with one key replays for any other.
+std::string request_key(std::string_view path, std::string_view query);
+
+fixtures fixtures_from_region_cache(const nlohmann::json& countries,
+                                    const std::string& region);
+
+fixtures fixtures_from_recording(const nlohmann::json& recording);
+
+struct fault_profile {
+    std::chrono::milliseconds latency{0};
+    std::chrono::milliseconds jitter{0};
+    double throttle_rate{0.0};
+    std::chrono::seconds retry_after{1};
+    double server_error_rate{0.0};
+    // Requests that are held for `stall` and then dropped without a response,
+    // so the client sees a timeout or a closed connection.
+    double timeout_rate{0.0};
+    std::chrono::milliseconds stall{1000};
+    std::size_t slow_body_chunk{0};
+    std::chrono::milliseconds slow_body_delay{0};
+    std::uint64_t seed{42};
+};
+
+struct stats {
+    std::size_t requests;
+    std::size_t throttled;
+    std::size_t server_errors;
+    std::size_t timeouts;
+    std::size_t not_found;
+};
+
+class server {
+public:
+    explicit server(fixtures responses, fault_profile faults = {}, std::uint16_t port = 0);
+    ~server();
+
+    server(const server&) = delete;
+    server& operator=(const server&) = delete;
+
+    std::uint16_t port() const;
+    std::string base_url() const;
+
+    void set_faults(const fault_profile& faults);
+    stats statistics() const;
+    void reset_statistics();
+
+    void stop();
+
+private:
+    void accept_loop();
+    void serve(int client);
+    response respond(const std::string& key);
+
+    const fixtures responses_;
+
+    mutable std::mutex mutex_;
+    fault_profile faults_;
+    std::unordered_map<std::string, std::uint64_t> attempts_;
+    std::vector<std::jthread> connections_;
+
+    std::atomic<std::size_t> requests_{0};
+    std::atomic<std::size_t> throttled_{0};
+    std::atomic<std::size_t> server_errors_{0};
+    std::atomic<std::size_t> timeouts_{0};
+    std::atomic<std::size_t> not_found_{0};
+
+    std::atomic<bool> running_{true};
+    int listen_fd_{-1};
+    std::uint16_t port_{0};
+    std::jthread acceptor_;
+};
+
+}  // namespace replay
+
+#endif  // !REPLAY_SERVER_H
@@ -0,0 +1,51 @@
+#ifndef SYNTHETIC_GRAPH_H
+#define SYNTHETIC_GRAPH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "boundary.h"
+#include "country.h"
+#include "country_store.h"
+
+namespace synthetic {
+
+enum class topology {
+    planar,
+    near_planar,
+    random_geometric,
+};
+
+struct graph {
+    std::vector<capital_coordinates> coords;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+};
+
+const char* to_string(topology t);
+
+graph generate(topology t, std::size_t number_of_nodes, std::uint64_t seed = 42);
+
+std::string node_key(std::uint32_t index);
+
+std::unordered_map<std::string, country> to_countries(const graph& g);
+
+country_store to_store(const graph& g);
+
+// Square-ish cells on a jittered lattice with 0.05 degree sides, like
+// provinces tiling a region, numbered row by row. Shared outlines reuse the
+// lattice points and split every side the same way; digitised ones split each
+// side differently and move every vertex by a few metres, so only the
+// tolerance pass can pair them up.
+std::vector<boundary> lattice_boundaries(std::size_t count, bool shared,
+                                                 std::uint64_t seed = 42);
+
+// Sides shared by horizontally or vertically adjacent lattice cells.
+std::size_t lattice_borders(std::size_t count);
+
+}  // namespace synthetic
+
+#endif  // !SYNTHETIC_GRAPH_H
@@ -0,0 +1,108 @@
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "replay_server.h"
+
+namespace {
+
+volatile std::sig_atomic_t running = 1;
+
+void handle_signal(int) { running = 0; }
+
+void print_usage() {
+    std::cerr << "usage: mock_geodata_server --fixtures <file> [--region <name>] "
+                 "[--port <port>] [--latency-ms <ms>] [--jitter-ms <ms>] "
+                 "[--throttle-rate <0..1>] [--retry-after-s <s>] [--error-rate <0..1>] "
+                 "[--timeout-rate <0..1>] [--stall-ms <ms>] "
+                 "[--slow-body-bytes <bytes>] [--slow-body-delay-ms <ms>] [--seed <n>]"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string fixtures_filename;
+    std::string region = "europe";
+    std::uint16_t port = 8080;
+    replay::fault_profile faults;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string_view option = argv[i];
+        const std::string value = argv[i + 1];
+
+        if (option == "--fixtures") {
+            fixtures_filename = value;
+        } else if (option == "--region") {
+            region = value;
+        } else if (option == "--port") {
+            port = static_cast<std::uint16_t>(std::stoi(value));
+        } else if (option == "--latency-ms") {
+            faults.latency = std::chrono::milliseconds(std::stol(value));
+        } else if (option == "--jitter-ms") {
+            faults.jitter = std::chrono::milliseconds(std::stol(value));
+        } else if (option == "--throttle-rate") {
+            faults.throttle_rate = std::stod(value);
+        } else if (option == "--retry-after-s") {
+            faults.retry_after = std::chrono::seconds(std::stol(value));
+        } else if (option == "--error-rate") {
+            faults.server_error_rate = std::stod(value);
+        } else if (option == "--timeout-rate") {
+            faults.timeout_rate = std::stod(value);
+        } else if (option == "--stall-ms") {
+            faults.stall = std::chrono::milliseconds(std::stol(value));
+        } else if (option == "--slow-body-bytes") {
+            faults.slow_body_chunk = std::stoul(value);
+        } else if (option == "--slow-body-delay-ms") {
+            faults.slow_body_delay = std::chrono::milliseconds(std::stol(value));
+        } else if (option == "--seed") {
+            faults.seed = std::stoull(value);
+        } else {
+            print_usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (fixtures_filename.empty()) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream file(fixtures_filename);
+
+    if (!file.is_open()) {
+        std::cerr << "error: cannot open fixtures file '" << fixtures_filename << "'"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    const nlohmann::json fixtures = nlohmann::json::parse(file);
+
+    replay::server server(fixtures.is_array()
+                              ? replay::fixtures_from_recording(fixtures)
+                              : replay::fixtures_from_region_cache(fixtures, region),
+                          faults, port);
+
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    std::cout << "Serving " << fixtures_filename << " on " << server.base_url() << std::endl;
+
+    while (running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    const auto s = server.statistics();
+
+    std::cout << "Requests: " << s.requests << ", throttled: " << s.throttled
+              << ", server errors: " << s.server_errors << ", timeouts: " << s.timeouts
+              << ", not found: " << s.not_found
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
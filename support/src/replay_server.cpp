@@ -0,0 +1,419 @@
+#include "replay_server.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace replay {
+
+namespace {
+
+const char* reason_phrase(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 404:
+            return "Not Found";
+        case 429:
+            return "Too Many Requests";
+        case 500:
+            return "Internal Server Error";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Unknown";
+    }
+}
+
+bool send_all(int fd, std::string_view data) {
+    while (!data.empty()) {
+        const ssize_t sent = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+
+        if (sent <= 0) {
+            return false;
+        }
+
+        data.remove_prefix(static_cast<std::size_t>(sent));
+    }
+
+    return true;
+}
+
+bool iequals(std::string_view a, std::string_view b) {
+    return std::ranges::equal(a, b, [](char x, char y) {
+        return std::tolower(static_cast<unsigned char>(x)) ==
+               std::tolower(static_cast<unsigned char>(y));
+    });
+}
+
+}  // namespace
+
+std::string request_key(std::string_view path, std::string_view query) {
+    std::vector<std::string_view> parameters;
+
+    while (!query.empty()) {
+        const auto end = query.find('&');
+        const auto parameter = query.substr(0, end);
+
+        if (!parameter.empty() && !parameter.starts_with("key=")) {
+            parameters.push_back(parameter);
+        }
+
+        query = end == std::string_view::npos ? std::string_view{} : query.substr(end + 1);
+    }
+
+    std::ranges::sort(parameters);
+
+    std::string key(path);
+
+    for (std::size_t i = 0; i < parameters.size(); i++) {
+        key += (i == 0 ? '?' : '&');
+        key += parameters[i];
+    }
+
+    return key;
+}
+
+fixtures fixtures_from_region_cache(const nlohmann::json& countries,
+                                    const std::string& region) {
+    fixtures result;
+
+    nlohmann::json region_codes = nlohmann::json::array();
+
+    for (const auto& [iso, country] : countries.items()) {
+        region_codes.push_back(
+            {{"cca2", iso}, {"name", {{"common", country["name"]}}}});
+
+        nlohmann::json capital_info = nlohmann::json::object();
+
+        if (const auto coords = country.find("capital_coords");
+            coords != country.end() && !coords->is_null()) {
+            capital_info["latlng"] = {(*coords)["latitude"], (*coords)["longitude"]};
+        }
+
+        nlohmann::json alpha = nlohmann::json::array();
+        alpha.push_back({{"cca2", iso},
+                         {"name", {{"common", country["name"]}}},
+                         {"capital", {country["capital"]}},
+                         {"capitalInfo", capital_info}});
+
+        result.emplace(request_key("/v3.1/alpha/" + iso, ""),
+                       response{.status = 200, .body = alpha.dump()});
+
+        nlohmann::json neighbours = nlohmann::json::array();
+
+        for (const auto& neighbour_iso : country["neighboring_countries_iso"]) {
+            const std::string code = neighbour_iso.get<std::string>();
+            const std::string name =
+                countries.contains(code) ? countries[code]["name"].get<std::string>() : code;
+
+            neighbours.push_back({{"country_code", code}, {"country_name", name}});
+        }
+
+        result.emplace(request_key("/v2/neighboring-countries",
+                                   "country_code=" + iso + "&format=json"),
+                       response{.status = 200, .body = neighbours.dump()});
+    }
+
+    result.emplace(request_key("/v3.1/region/" + region, ""),
+                   response{.status = 200, .body = region_codes.dump()});
+
+    return result;
+}
+
+fixtures fixtures_from_recording(const nlohmann::json& recording) {
+    fixtures result;
+
+    for (const auto& entry : recording) {
+        response r{.status = entry.value("status", 200), .body = {}};
+
+        if (entry.contains("body")) {
+            r.body = entry["body"].is_string() ? entry["body"].get<std::string>()
+                                               : entry["body"].dump();
+        }
+
+        if (entry.contains("headers")) {
+            for (const auto& [name, value] : entry["headers"].items()) {
+                r.headers.emplace_back(name, value.get<std::string>());
+            }
+        }
+
+        result.insert_or_assign(
+            request_key(entry["path"].get<std::string>(), entry.value("query", "")),
+            std::move(r));
+    }
+
+    return result;
+}
+
+server::server(fixtures responses, fault_profile faults, std::uint16_t port)
+    : responses_(std::move(responses)), faults_(faults) {
+    listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+
+    if (listen_fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+
+    const int reuse = 1;
+    ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+
+    if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listen_fd_, SOMAXCONN) < 0) {
+        const int bind_error = errno;
+        ::close(listen_fd_);
+        throw std::system_error(bind_error, std::generic_category(), "bind/listen");
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    acceptor_ = std::jthread([this] { accept_loop(); });
+}
+
+server::~server() { stop(); }
+
+std::uint16_t server::port() const { return port_; }
+
+std::string server::base_url() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+void server::set_faults(const fault_profile& faults) {
+    std::lock_guard lock(mutex_);
+    faults_ = faults;
+    attempts_.clear();
+}
+
+stats server::statistics() const {
+    return stats{.requests = requests_,
+                 .throttled = throttled_,
+                 .server_errors = server_errors_,
+                 .timeouts = timeouts_,
+                 .not_found = not_found_};
+}
+
+void server::reset_statistics() {
+    requests_ = 0;
+    throttled_ = 0;
+    server_errors_ = 0;
+    timeouts_ = 0;
+    not_found_ = 0;
+}
+
+void server::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    ::shutdown(listen_fd_, SHUT_RDWR);
+    ::close(listen_fd_);
+
+    if (acceptor_.joinable()) {
+        acceptor_.join();
+    }
+
+    std::vector<std::jthread> connections;
+
+    {
+        std::lock_guard lock(mutex_);
+        connections.swap(connections_);
+    }
+
+    connections.clear();
+}
+
+void server::accept_loop() {
+    while (running_) {
+        const int client = ::accept(listen_fd_, nullptr, nullptr);
+
+        if (client < 0) {
+            if (!running_) {
+                break;
+            }
+
+            continue;
+        }
+
+        timeval timeout{.tv_sec = 1, .tv_usec = 0};
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        std::lock_guard lock(mutex_);
+        connections_.emplace_back([this, client] { serve(client); });
+    }
+}
+
+void server::serve(int client) {
+    std::string buffer;
+    char chunk[4096];
+
+    while (running_) {
+        auto header_end = buffer.find("\r\n\r\n");
+
+        while (header_end == std::string::npos) {
+            const ssize_t received = ::recv(client, chunk, sizeof(chunk), 0);
+
+            if (received <= 0) {
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && running_) {
+                    continue;
+                }
+
+                ::close(client);
+                return;
+            }
+
+            buffer.append(chunk, static_cast<std::size_t>(received));
+            header_end = buffer.find("\r\n\r\n");
+        }
+
+        const std::string_view head(buffer.data(), header_end);
+        const auto line_end = head.find("\r\n");
+        const std::string_view request_line = head.substr(0, line_end);
+
+        const auto target_begin = request_line.find(' ') + 1;
+        const auto target_end = request_line.find(' ', target_begin);
+        const std::string_view target =
+            request_line.substr(target_begin, target_end - target_begin);
+        const auto query_begin = target.find('?');
+
+        const std::string key =
+            query_begin == std::string_view::npos
+                ? request_key(target, "")
+                : request_key(target.substr(0, query_begin), target.substr(query_begin + 1));
+
+        bool keep_alive = !request_line.ends_with("HTTP/1.0");
+
+        for (std::string_view rest = head.substr(line_end + 2); !rest.empty();) {
+            const auto end = rest.find("\r\n");
+            const std::string_view header = rest.substr(0, end);
+
+            if (const auto colon = header.find(':'); colon != std::string_view::npos &&
+                                                     iequals(header.substr(0, colon), "connection")) {
+                keep_alive = !header.substr(colon + 1).contains("close");
+            }
+
+            rest = end == std::string_view::npos ? std::string_view{} : rest.substr(end + 2);
+        }
+
+        buffer.erase(0, header_end + 4);
+
+        fault_profile faults;
+
+        {
+            std::lock_guard lock(mutex_);
+            faults = faults_;
+        }
+
+        const response r = respond(key);
+
+        // A stalled request: drop the connection without replying.
+        if (r.status == 0) {
+            break;
+        }
+
+        std::string header = "HTTP/1.1 " + std::to_string(r.status) + " " +
+                             reason_phrase(r.status) +
+                             "\r\nContent-Type: application/json\r\nContent-Length: " +
+                             std::to_string(r.body.size()) + "\r\n";
+
+        for (const auto& [name, value] : r.headers) {
+            header += name + ": " + value + "\r\n";
+        }
+
+        header += keep_alive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+
+        bool sent = send_all(client, header);
+
+        if (faults.slow_body_chunk == 0) {
+            sent = sent && send_all(client, r.body);
+        } else {
+            for (std::size_t offset = 0; sent && offset < r.body.size();
+                 offset += faults.slow_body_chunk) {
+                std::this_thread::sleep_for(faults.slow_body_delay);
+                sent = send_all(client, std::string_view(r.body).substr(
+                                            offset, faults.slow_body_chunk));
+            }
+        }
+
+        if (!sent || !keep_alive) {
+            break;
+        }
+    }
+
+    ::close(client);
+}
+
+response server::respond(const std::string& key) {
+    requests_++;
+
+    fault_profile faults;
+    std::uint64_t attempt = 0;
+
+    {
+        std::lock_guard lock(mutex_);
+        faults = faults_;
+        attempt = attempts_[key]++;
+    }
+
+    // Faults are drawn per (target, attempt), so concurrent clients see the same
+    // sequence of failures regardless of the order in which requests arrive.
+    std::mt19937_64 rng(faults.seed ^ std::hash<std::string>{}(key) ^
+                        (attempt * 0x9E3779B97F4A7C15ULL));
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    auto delay = faults.latency;
+
+    if (faults.jitter.count() > 0) {
+        delay += std::chrono::milliseconds(
+            static_cast<long>(unit(rng) * static_cast<double>(faults.jitter.count())));
+    }
+
+    std::this_thread::sleep_for(delay);
+
+    const double roll = unit(rng);
+
+    if (roll < faults.throttle_rate) {
+        throttled_++;
+        return response{.status = 429,
+                        .body = R"({"error":"rate limit exceeded"})",
+                        .headers = {{"Retry-After",
+                                     std::to_string(faults.retry_after.count())}}};
+    }
+
+    if (roll < faults.throttle_rate + faults.server_error_rate) {
+        server_errors_++;
+        return response{.status = 503, .body = R"({"error":"service unavailable"})"};
+    }
+
+    if (roll < faults.throttle_rate + faults.server_error_rate + faults.timeout_rate) {
+        timeouts_++;
+        std::this_thread::sleep_for(faults.stall);
+        return response{.status = 0, .body = {}};
+    }
+
+    const auto it = responses_.find(key);
+
+    if (it == responses_.end()) {
+        not_found_++;
+        return response{.status = 404, .body = R"({"error":"no recorded response"})"};
+    }
+
+    return it->second;
+}
+
+}  // namespace replay
@@ -0,0 +1,319 @@
+#include "synthetic_graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "boundary.h"
+#include "country.h"
+#include "country_store.h"
+
+namespace synthetic {
+
+namespace {
+
+constexpr double min_latitude = 35.0;
+constexpr double max_latitude = 70.0;
+constexpr double min_longitude = -10.0;
+constexpr double max_longitude = 40.0;
+
+constexpr double cell_degrees = 0.05;
+
+capital_coordinates to_coordinates(double x, double y, double extent) {
+    return {.latitude = min_latitude + (y / extent) * (max_latitude - min_latitude),
+            .longitude = min_longitude + (x / extent) * (max_longitude - min_longitude)};
+}
+
+std::uint64_t edge_key(std::uint32_t u, std::uint32_t v) {
+    if (u > v) {
+        std::swap(u, v);
+    }
+
+    return (static_cast<std::uint64_t>(u) << 32) | v;
+}
+
+graph generate_planar(std::size_t number_of_nodes, std::mt19937_64& rng) {
+    graph g;
+
+    const auto side =
+        static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(number_of_nodes))));
+    const auto n = static_cast<std::uint32_t>(number_of_nodes);
+
+    std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+    std::bernoulli_distribution flip(0.5);
+
+    g.coords.reserve(n);
+
+    for (std::uint32_t i = 0; i < n; i++) {
+        const double x = (i % side) + jitter(rng);
+        const double y = (i / side) + jitter(rng);
+        g.coords.push_back(to_coordinates(x, y, side));
+    }
+
+    for (std::uint32_t i = 0; i < n; i++) {
+        const bool has_right = (i % side) + 1 < side && i + 1 < n;
+        const bool has_down = i + side < n;
+
+        if (has_right) {
+            g.edges.emplace_back(i, i + 1);
+        }
+
+        if (has_down) {
+            g.edges.emplace_back(i, i + side);
+        }
+
+        if (has_right && i + side + 1 < n) {
+            if (flip(rng)) {
+                g.edges.emplace_back(i, i + side + 1);
+            } else {
+                g.edges.emplace_back(i + 1, i + side);
+            }
+        }
+    }
+
+    return g;
+}
+
+graph generate_near_planar(std::size_t number_of_nodes, std::mt19937_64& rng) {
+    graph g = generate_planar(number_of_nodes, rng);
+
+    if (number_of_nodes < 2) {
+        return g;
+    }
+
+    std::unordered_set<std::uint64_t> existing;
+
+    for (const auto& [u, v] : g.edges) {
+        existing.insert(edge_key(u, v));
+    }
+
+    std::uniform_int_distribution<std::uint32_t> pick(
+        0, static_cast<std::uint32_t>(number_of_nodes - 1));
+
+    const std::size_t extra_edges = std::max<std::size_t>(1, number_of_nodes / 50);
+
+    for (std::size_t added = 0; added < extra_edges;) {
+        const std::uint32_t u = pick(rng);
+        const std::uint32_t v = pick(rng);
+
+        if (u == v || !existing.insert(edge_key(u, v)).second) {
+            continue;
+        }
+
+        g.edges.emplace_back(u, v);
+        added++;
+    }
+
+    return g;
+}
+
+graph generate_random_geometric(std::size_t number_of_nodes, std::mt19937_64& rng) {
+    constexpr double average_degree = 6.0;
+
+    graph g;
+
+    const auto n = static_cast<std::uint32_t>(number_of_nodes);
+    const double radius = std::sqrt(average_degree / (std::numbers::pi * number_of_nodes));
+    const auto cells_per_side = static_cast<std::uint32_t>(std::max(1.0, 1.0 / radius));
+
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<double> xs(n);
+    std::vector<double> ys(n);
+    std::vector<std::vector<std::uint32_t>> cells(cells_per_side * cells_per_side);
+
+    auto cell_of = [&](double value) {
+        return std::min(cells_per_side - 1, static_cast<std::uint32_t>(value * cells_per_side));
+    };
+
+    for (std::uint32_t i = 0; i < n; i++) {
+        xs[i] = unit(rng);
+        ys[i] = unit(rng);
+        cells[cell_of(ys[i]) * cells_per_side + cell_of(xs[i])].push_back(i);
+        g.coords.push_back(to_coordinates(xs[i], ys[i], 1.0));
+    }
+
+    const double radius_squared = radius * radius;
+
+    for (std::uint32_t i = 0; i < n; i++) {
+        const std::uint32_t cx = cell_of(xs[i]);
+        const std::uint32_t cy = cell_of(ys[i]);
+
+        for (std::uint32_t y = (cy == 0 ? 0 : cy - 1);
+             y <= std::min(cells_per_side - 1, cy + 1); y++) {
+            for (std::uint32_t x = (cx == 0 ? 0 : cx - 1);
+                 x <= std::min(cells_per_side - 1, cx + 1); x++) {
+                for (std::uint32_t j : cells[y * cells_per_side + x]) {
+                    if (j <= i) {
+                        continue;
+                    }
+
+                    const double dx = xs[i] - xs[j];
+                    const double dy = ys[i] - ys[j];
+
+                    if (dx * dx + dy * dy <= radius_squared) {
+                        g.edges.emplace_back(i, j);
+                    }
+                }
+            }
+        }
+    }
+
+    return g;
+}
+
+}  // namespace
+
+const char* to_string(topology t) {
+    switch (t) {
+        case topology::planar:
+            return "planar";
+        case topology::near_planar:
+            return "near_planar";
+        case topology::random_geometric:
+            return "random_geometric";
+    }
+
+    return "unknown";
+}
+
+graph generate(topology t, std::size_t number_of_nodes, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+
+    switch (t) {
+        case topology::planar:
+            return generate_planar(number_of_nodes, rng);
+        case topology::near_planar:
+            return generate_near_planar(number_of_nodes, rng);
+        case topology::random_geometric:
+            return generate_random_geometric(number_of_nodes, rng);
+    }
+
+    return {};
+}
+
+std::string node_key(std::uint32_t index) { return "N" + std::to_string(index); }
+
+std::unordered_map<std::string, country> to_countries(const graph& g) {
+    std::unordered_map<std::string, country> countries;
+    countries.reserve(g.coords.size());
+
+    std::vector<std::string> keys;
+    keys.reserve(g.coords.size());
+
+    for (std::uint32_t i = 0; i < g.coords.size(); i++) {
+        keys.push_back(node_key(i));
+
+        country c;
+        c.name = "Country " + std::to_string(i);
+        c.iso_code = keys.back();
+        c.capital = "Capital " + std::to_string(i);
+        c.capital_coords = g.coords[i];
+
+        countries.emplace(keys.back(), std::move(c));
+    }
+
+    for (const auto& [u, v] : g.edges) {
+        countries[keys[u]].neighboring_countries_iso.push_back(keys[v]);
+        countries[keys[v]].neighboring_countries_iso.push_back(keys[u]);
+    }
+
+    return countries;
+}
+
+country_store to_store(const graph& g) {
+    std::vector<std::vector<std::string>> neighbours(g.coords.size());
+
+    for (const auto& [u, v] : g.edges) {
+        neighbours[u].push_back(node_key(v));
+        neighbours[v].push_back(node_key(u));
+    }
+
+    country_store store;
+    store.reserve(g.coords.size(), g.edges.size() * 2);
+
+    std::vector<std::string_view> neighbour_views;
+
+    for (std::uint32_t i = 0; i < g.coords.size(); i++) {
+        neighbour_views.assign(neighbours[i].begin(), neighbours[i].end());
+        store.add("Country " + std::to_string(i), node_key(i), "Capital " + std::to_string(i),
+                  g.coords[i], neighbour_views);
+    }
+
+    store.link();
+
+    return store;
+}
+
+std::vector<boundary> lattice_boundaries(std::size_t count, bool shared,
+                                                 std::uint64_t seed) {
+    const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> jitter(-0.2 * cell_degrees, 0.2 * cell_degrees);
+    std::uniform_real_distribution<double> noise(-5e-5, 5e-5);
+
+    std::vector<geo_point> lattice;
+
+    for (std::size_t y = 0; y <= side; y++) {
+        for (std::size_t x = 0; x <= side; x++) {
+            const double longitude = 5.0 + static_cast<double>(x) * cell_degrees;
+            const double latitude = 40.0 + static_cast<double>(y) * cell_degrees;
+
+            lattice.push_back(
+                {.longitude = longitude + jitter(rng), .latitude = latitude + jitter(rng)});
+        }
+    }
+
+    auto at = [&](std::size_t x, std::size_t y) { return lattice[y * (side + 1) + x]; };
+
+    std::vector<boundary> cells;
+
+    for (std::size_t y = 0; y < side; y++) {
+        for (std::size_t x = 0; x < side && cells.size() < count; x++) {
+            const geo_point corners[] = {at(x, y), at(x + 1, y), at(x + 1, y + 1),
+                                                  at(x, y + 1)};
+            const std::size_t pieces = shared ? 4 : 3 + (x + y) % 3;
+
+            std::vector<geo_point> ring;
+
+            for (std::size_t c = 0; c < 4; c++) {
+                const auto& a = corners[c];
+                const auto& b = corners[(c + 1) % 4];
+
+                for (std::size_t k = 0; k < pieces; k++) {
+                    const double t = static_cast<double>(k) / static_cast<double>(pieces);
+                    const double offset = shared || k == 0 ? 0.0 : noise(rng);
+
+                    ring.push_back(
+                        {.longitude = a.longitude + (b.longitude - a.longitude) * t + offset,
+                         .latitude = a.latitude + (b.latitude - a.latitude) * t + offset});
+                }
+            }
+
+            const std::string code = "C" + std::to_string(cells.size());
+            cells.push_back({.name = code, .code = code, .rings = {std::move(ring)}});
+        }
+    }
+
+    return cells;
+}
+
+std::size_t lattice_borders(std::size_t count) {
+    const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+    const std::size_t rows = count / side;
+    const std::size_t last = count % side;
+
+    return rows * (side - 1) + (rows > 0 ? (rows - 1) * side : 0) +
+           (last > 0 ? (last - 1) + last : 0);
+}
+
+}  // namespace synthetic
@@ -0,0 +1,38 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <source_location>
+#include <string_view>
+
+namespace test {
+
+inline int failures = 0;
+
+inline void expect(bool condition, std::string_view what,
+                   std::source_location where = std::source_location::current()) {
+    if (condition) {
+        return;
+    }
+
+    failures++;
+    std::cerr << where.file_name() << ":" << where.line() << ": expected " << what
+              << std::endl;
+}
+
+// Runs one case and reports it; failures inside the case are counted by expect.
+inline void run(std::string_view name, const std::function<void()>& body) {
+    const int before = failures;
+
+    body();
+
+    std::cout << (failures == before ? "[ OK ] " : "[FAIL] ") << name << std::endl;
+}
+
+inline int result() { return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE; }
+
+}  // namespace test
+
+#endif  // !TEST_COMMON_H
@@ -0,0 +1,44 @@
+#ifndef TEST_GRAPHS_H
+#define TEST_GRAPHS_H
+
+#include <ogdf/basic/Graph.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "synthetic_graph.h"
+
+namespace test {
+
+inline std::vector<ogdf::node> to_ogdf(const synthetic::graph& g, ogdf::Graph& graph) {
+    std::vector<ogdf::node> nodes;
+    nodes.reserve(g.coords.size());
+
+    for (std::size_t i = 0; i < g.coords.size(); i++) {
+        nodes.push_back(graph.newNode());
+    }
+
+    for (const auto& [u, v] : g.edges) {
+        graph.newEdge(nodes[u], nodes[v]);
+    }
+
+    return nodes;
+}
+
+inline std::vector<ogdf::node> path(std::size_t length, ogdf::Graph& graph) {
+    std::vector<ogdf::node> nodes;
+
+    for (std::size_t i = 0; i < length; i++) {
+        nodes.push_back(graph.newNode());
+
+        if (i > 0) {
+            graph.newEdge(nodes[i - 1], nodes[i]);
+        }
+    }
+
+    return nodes;
+}
+
+}  // namespace test
+
+#endif  // !TEST_GRAPHS_H
@@ -0,0 +1,24 @@
+#ifndef TEST_TOPOLOGIES_H
+#define TEST_TOPOLOGIES_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "synthetic_graph.h"
+#include "test_common.h"
+
+namespace test {
+
+// Runs the case once per synthetic topology, reported as "<name>/<topology>".
+inline void run_per_topology(std::string_view name,
+                             const std::function<void(synthetic::topology)>& body) {
+    for (const auto t : {synthetic::topology::planar, synthetic::topology::near_planar,
+                         synthetic::topology::random_geometric}) {
+        run(std::string(name) + "/" + synthetic::to_string(t), [&] { body(t); });
+    }
+}
+
+}  // namespace test
+
+#endif  // !TEST_TOPOLOGIES_H
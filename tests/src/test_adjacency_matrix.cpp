@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "adjacency_matrix.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_topologies.h"
+
+namespace {
+
+using vertex = adjacency_matrix::vertex;
+using edge_list = std::vector<std::pair<vertex, vertex>>;
+
+adjacency_matrix matrix_for(std::size_t vertices, const edge_list& edges) {
+    adjacency_matrix matrix(vertices);
+
+    for (const auto& [u, v] : edges) {
+        matrix.add_edge(u, v);
+    }
+
+    return matrix;
+}
+
+edge_list complete(vertex n) {
+    edge_list edges;
+
+    for (vertex u = 0; u < n; u++) {
+        for (vertex v = u + 1; v < n; v++) {
+            edges.emplace_back(u, v);
+        }
+    }
+
+    return edges;
+}
+
+edge_list cycle(vertex n) {
+    edge_list edges;
+
+    for (vertex u = 0; u < n; u++) {
+        edges.emplace_back(u, (u + 1) % n);
+    }
+
+    return edges;
+}
+
+std::vector<std::vector<vertex>> lists_for(std::size_t vertices, const edge_list& edges) {
+    std::vector<std::vector<vertex>> lists(vertices);
+
+    for (const auto& [u, v] : edges) {
+        lists[u].push_back(v);
+        lists[v].push_back(u);
+    }
+
+    for (auto& list : lists) {
+        std::ranges::sort(list);
+        list.erase(std::ranges::unique(list).begin(), list.end());
+    }
+
+    return lists;
+}
+
+// Every length up to a few 256-bit blocks, so whichever kernel the CPU picks
+// sees whole blocks as well as a scalar tail.
+void and_popcount_lengths() {
+    std::mt19937_64 rng(3);
+    bool same = true;
+
+    for (std::size_t words = 0; words <= 20; words++) {
+        std::vector<std::uint64_t> a(words);
+        std::vector<std::uint64_t> b(words);
+        std::size_t expected = 0;
+
+        for (std::size_t w = 0; w < words; w++) {
+            a[w] = rng();
+            b[w] = rng();
+            expected += static_cast<std::size_t>(std::popcount(a[w] & b[w]));
+        }
+
+        same = same && and_popcount(a.data(), b.data(), words) == expected;
+    }
+
+    test::expect(same, "the popcount of a & b for every length");
+}
+
+void small_graphs() {
+    const auto k5 = matrix_for(5, complete(5));
+    const auto c6 = matrix_for(6, cycle(6));
+
+    test::expect(count_triangles(k5) == 10, "10 triangles in K5");
+    test::expect(count_triangles(c6) == 0, "no triangles in a 6-cycle");
+    test::expect(global_clustering(k5) == 1.0 && average_clustering(k5) == 1.0,
+                 "clustering 1 in K5");
+    test::expect(global_clustering(c6) == 0.0 && average_clustering(c6) == 0.0,
+                 "clustering 0 in a 6-cycle");
+    test::expect(std::ranges::all_of(core_numbers(k5), [](std::uint32_t c) { return c == 4; }),
+                 "core number 4 everywhere in K5");
+    test::expect(std::ranges::all_of(core_numbers(c6), [](std::uint32_t c) { return c == 2; }),
+                 "core number 2 everywhere in a cycle");
+
+    const auto k5_colors = dsatur_coloring(k5);
+    const auto c6_colors = dsatur_coloring(c6);
+
+    test::expect(std::ranges::max(k5_colors) == 4, "five colours for K5");
+    test::expect(std::ranges::max(c6_colors) == 1, "two colours for an even cycle");
+
+    auto k4 = matrix_for(5, complete(5));
+    k4.remove_edge(0, 1);
+
+    test::expect(!k4.has_edge(0, 1) && !k4.has_edge(1, 0) && k4.degree(0) == 3,
+                 "a removed edge gone in both directions");
+    test::expect(k4.common_neighbours(0, 1) == 3, "three common neighbours after the removal");
+    test::expect(count_triangles(k4) == 7, "the three triangles through the edge gone");
+}
+
+// Triangles, k-cores and DSATUR against plain adjacency lists.
+void against_lists(synthetic::topology t) {
+    const auto g = synthetic::generate(t, 2000);
+    const edge_list edges(g.edges.begin(), g.edges.end());
+    const auto matrix = matrix_for(g.coords.size(), edges);
+    const auto lists = lists_for(g.coords.size(), edges);
+
+    std::vector<std::uint32_t> per_vertex(lists.size(), 0);
+    std::size_t triangles = 0;
+    bool common = true;
+
+    for (vertex u = 0; u < lists.size(); u++) {
+        for (const vertex v : lists[u]) {
+            std::vector<vertex> shared;
+            std::ranges::set_intersection(lists[u], lists[v], std::back_inserter(shared));
+
+            common = common && matrix.common_neighbours(u, v) == shared.size();
+
+            for (const vertex w : shared) {
+                if (u < v && v < w) {
+                    triangles++;
+                    per_vertex[u]++;
+                    per_vertex[v]++;
+                    per_vertex[w]++;
+                }
+            }
+        }
+    }
+
+    test::expect(common, "the common neighbours of every edge");
+    test::expect(count_triangles(matrix) == triangles, "the triangles of the lists");
+    test::expect(triangles_per_vertex(matrix) == per_vertex,
+                 "each triangle counted at each of its corners");
+
+    // Peeling the smallest degree first gives the core numbers directly.
+    std::vector<std::uint32_t> degree(lists.size());
+    std::vector<std::uint32_t> cores(lists.size(), 0);
+    std::vector<char> removed(lists.size(), 0);
+    std::uint32_t core = 0;
+
+    for (vertex v = 0; v < lists.size(); v++) {
+        degree[v] = static_cast<std::uint32_t>(lists[v].size());
+    }
+
+    for (std::size_t round = 0; round < lists.size(); round++) {
+        vertex next = 0;
+        std::uint32_t smallest = UINT32_MAX;
+
+        for (vertex v = 0; v < lists.size(); v++) {
+            if (!removed[v] && degree[v] < smallest) {
+                smallest = degree[v];
+                next = v;
+            }
+        }
+
+        core = std::max(core, smallest);
+        cores[next] = core;
+        removed[next] = 1;
+
+        for (const vertex w : lists[next]) {
+            degree[w]--;
+        }
+    }
+
+    test::expect(core_numbers(matrix) == cores, "the core numbers of repeated peeling");
+
+    const auto colors = dsatur_coloring(matrix);
+
+    test::expect(std::ranges::none_of(edges, [&](const auto& e) {
+                     return colors[e.first] == colors[e.second];
+                 }),
+                 "no border between two countries of one colour");
+}
+
+}  // namespace
+
+int main() {
+    test::run("and_popcount_lengths", and_popcount_lengths);
+    test::run("small_graphs", small_graphs);
+
+    test::run_per_topology("against_lists", against_lists);
+
+    return test::result();
+}
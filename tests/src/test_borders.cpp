@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <numbers>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "border_adjacency.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+
+namespace {
+
+constexpr double km_per_degree = 6371.0 * std::numbers::pi / 180.0;
+
+boundary square(std::string code, double longitude, double latitude, double side) {
+    return {.name = code,
+            .code = code,
+            .rings = {{{.longitude = longitude, .latitude = latitude},
+                       {.longitude = longitude + side, .latitude = latitude},
+                       {.longitude = longitude + side, .latitude = latitude + side},
+                       {.longitude = longitude, .latitude = latitude + side},
+                       {.longitude = longitude, .latitude = latitude}}}};
+}
+
+bool near(double a, double b, double relative) {
+    return std::abs(a - b) <= relative * std::abs(b);
+}
+
+void shared_side() {
+    // C only touches B at a corner.
+    const std::vector<boundary> boundaries{square("A", 0.0, 0.0, 0.1),
+                                                    square("B", 0.1, 0.0, 0.1),
+                                                    square("C", 0.2, 0.1, 0.1)};
+
+    const auto borders = spatial::find_shared_borders(boundaries);
+
+    test::expect(borders.size() == 1, "one shared border, got " + std::to_string(borders.size()));
+
+    if (borders.size() == 1) {
+        test::expect(borders[0].first == 0 && borders[0].second == 1, "A and B to be neighbours");
+        test::expect(near(borders[0].length_km, 0.1 * km_per_degree, 0.01),
+                     "a border as long as the side, got " +
+                         std::to_string(borders[0].length_km) + " km");
+    }
+}
+
+void tolerance() {
+    // B is moved about 11 m east, away from A.
+    const std::vector<boundary> boundaries{square("A", 0.0, 0.0, 0.1),
+                                                    square("B", 0.1001, 0.0, 0.1)};
+
+    test::expect(spatial::find_shared_borders(boundaries, {.tolerance_km = 0.0}).empty(),
+                 "no exact match across a gap");
+    test::expect(spatial::find_shared_borders(boundaries).size() == 1,
+                 "a match within the default tolerance");
+    test::expect(spatial::find_shared_borders(boundaries, {.tolerance_km = 0.005}).empty(),
+                 "no match beyond a 5 m tolerance");
+}
+
+// Every border is between cells next to each other in a row or a column.
+void lattice(bool shared) {
+    constexpr std::size_t count = 5000;
+    const auto side = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(count))));
+
+    const auto cells = synthetic::lattice_boundaries(count, shared);
+    const auto borders = spatial::find_shared_borders(cells, {.threads = 1});
+    const auto threaded = spatial::find_shared_borders(cells, {.threads = 4});
+
+    test::expect(borders.size() == synthetic::lattice_borders(count),
+                 "a border per shared lattice side, got " + std::to_string(borders.size()));
+
+    std::size_t misplaced = 0;
+
+    for (const auto& b : borders) {
+        const bool beside = b.second == b.first + 1 && b.second % side != 0;
+        const bool above = b.second == b.first + side;
+
+        misplaced += !(beside || above) ? 1 : 0;
+    }
+
+    test::expect(misplaced == 0,
+                 "borders only between lattice neighbours, " + std::to_string(misplaced) +
+                     " are not");
+
+    bool same = threaded.size() == borders.size();
+
+    for (std::size_t i = 0; same && i < borders.size(); i++) {
+        same = threaded[i].first == borders[i].first && threaded[i].second == borders[i].second &&
+               threaded[i].length_km == borders[i].length_km;
+    }
+
+    test::expect(same, "the same borders on any number of threads");
+}
+
+void store() {
+    const std::vector<boundary> boundaries{square("A", 0.0, 0.0, 0.1),
+                                                    square("B", 0.1, 0.0, 0.1),
+                                                    square("C", 0.0, 0.1, 0.1)};
+
+    const auto borders = spatial::find_shared_borders(boundaries);
+    const country_store countries = spatial::to_store(boundaries, borders);
+
+    test::expect(countries.size() == 3, "one entry per boundary");
+    test::expect(countries.neighbours(0).size() == 2, "A next to B and C");
+    test::expect(countries.neighbours(1).size() == 1 && countries.neighbours(1)[0] == 0,
+                 "B next to A only");
+
+    bool lengths = true;
+
+    for (const auto& b : borders) {
+        for (const auto& [from, to] :
+             {std::pair(b.first, b.second), std::pair(b.second, b.first)}) {
+            const auto neighbours = countries.neighbours(from);
+            const auto border_km = countries.border_km(from);
+            const auto at = std::ranges::find(neighbours, to) - neighbours.begin();
+
+            lengths = lengths && border_km.size() == neighbours.size() &&
+                      at < std::ssize(neighbours) && border_km[at] == b.length_km;
+        }
+    }
+
+    test::expect(lengths, "each border's length on both of its countries");
+    test::expect(countries[0].capital.empty(), "no capital name");
+    test::expect(countries[0].capital_coords &&
+                     near(countries[0].capital_coords->latitude, 0.05, 1e-9) &&
+                     near(countries[0].capital_coords->longitude, 0.05, 1e-9),
+                 "the centroid as the capital's position");
+}
+
+}  // namespace
+
+int main() {
+    test::run("shared_side", shared_side);
+    test::run("tolerance", tolerance);
+    test::run("lattice/shared", [] { lattice(true); });
+    test::run("lattice/digitised", [] { lattice(false); });
+    test::run("store", store);
+
+    return test::result();
+}
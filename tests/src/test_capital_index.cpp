@@ -0,0 +1,122 @@
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "capital_index.h"
+#include "country.h"
+#include "country_store.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_topologies.h"
+
+namespace {
+
+constexpr std::size_t k_nearest = 8;
+constexpr double radius_km = 250.0;
+
+bool same_matches(const std::vector<spatial::match>& a, const std::vector<spatial::match>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].index != b[i].index || a[i].distance_km != b[i].distance_km) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Around the capitals, so radius queries find something.
+std::vector<capital_coordinates> query_points(const synthetic::graph& g, std::size_t count) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<std::size_t> pick(0, g.coords.size() - 1);
+    std::normal_distribution<double> jitter(0.0, 0.5);
+
+    std::vector<capital_coordinates> points;
+
+    for (std::size_t i = 0; i < count; i++) {
+        const auto& c = g.coords[pick(rng)];
+        points.push_back(
+            {.latitude = c.latitude + jitter(rng), .longitude = c.longitude + jitter(rng)});
+    }
+
+    return points;
+}
+
+void against_brute_force(synthetic::topology t) {
+    const auto g = synthetic::generate(t, 5000);
+    const spatial::capital_index index(g.coords);
+    const auto queries = query_points(g, 256);
+
+    const auto batch_nearest = index.nearest(queries, k_nearest);
+    const auto batch_within = index.within(queries, radius_km);
+
+    std::size_t nearest_agree = 0;
+    std::size_t within_agree = 0;
+    std::size_t found = 0;
+
+    for (std::size_t i = 0; i < queries.size(); i++) {
+        const auto nearest = spatial::brute_force_nearest(g.coords, queries[i], k_nearest);
+        const auto within = spatial::brute_force_within(g.coords, queries[i], radius_km);
+
+        nearest_agree += same_matches(index.nearest(queries[i], k_nearest), nearest) &&
+                         same_matches(batch_nearest[i], nearest);
+        within_agree += same_matches(index.within(queries[i], radius_km), within) &&
+                        same_matches(batch_within[i], within);
+        found += within.size();
+    }
+
+    test::expect(index.size() == g.coords.size(), "every capital in the index");
+    test::expect(nearest_agree == queries.size(), "the nearest capitals of a linear scan");
+    test::expect(within_agree == queries.size(), "the capitals in range of a linear scan");
+    test::expect(found > queries.size(), "radius queries that find capitals");
+}
+
+void small_queries() {
+    const std::vector<capital_coordinates> capitals{{.latitude = 0.0, .longitude = 0.0},
+                                                    {.latitude = 0.0, .longitude = 1.0},
+                                                    {.latitude = 0.0, .longitude = 2.0}};
+    const spatial::capital_index index(capitals);
+    const capital_coordinates from{.latitude = 0.0, .longitude = 0.9};
+
+    const auto all = index.nearest(from, 10);
+
+    test::expect(all.size() == 3 && all[0].index == 1 && all[1].index == 0 && all[2].index == 2,
+                 "every capital by distance when k exceeds the index");
+    test::expect(index.nearest(from, 0).empty(), "nothing for k = 0");
+    test::expect(index.within(from, 1.0).empty(), "nothing in a radius short of every capital");
+    test::expect(spatial::capital_index().nearest(from, 3).empty(),
+                 "nothing from an empty index");
+}
+
+void store_without_coordinates() {
+    country_store countries;
+    const std::vector<std::string_view> none;
+
+    countries.add("A", "AA", "a", capital_coordinates{.latitude = 0.0, .longitude = 0.0}, none);
+    countries.add("B", "BB", "b", std::nullopt, none);
+    countries.add("C", "CC", "c", capital_coordinates{.latitude = 0.0, .longitude = 1.0}, none);
+    countries.link();
+
+    const spatial::capital_index index(countries);
+    const auto matches = index.nearest({.latitude = 0.0, .longitude = 0.1}, 3);
+
+    test::expect(index.size() == 2, "only capitals with coordinates");
+    test::expect(matches.size() == 2 && matches[0].index == 0 && matches[1].index == 2,
+                 "store indices in the matches");
+}
+
+}  // namespace
+
+int main() {
+    test::run_per_topology("against_brute_force", against_brute_force);
+
+    test::run("small_queries", small_queries);
+    test::run("store_without_coordinates", store_without_coordinates);
+
+    return test::result();
+}
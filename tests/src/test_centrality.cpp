@@ -0,0 +1,311 @@
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "capital_index.h"
+#include "centrality.h"
+#include "country.h"
+#include "country_store.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_graphs.h"
+#include "test_topologies.h"
+
+namespace {
+
+bool near(double a, double b, double relative = 1e-9) {
+    return std::abs(a - b) <= relative * std::max(1.0, std::abs(b));
+}
+
+void path_scores() {
+    ogdf::Graph graph;
+    test::path(5, graph);
+
+    const auto scores = compute_centrality(graph, {.threads = 1});
+
+    // The middle vertex lies on 4 of the 6 pairs of other vertices, its
+    // neighbour on 3 of them.
+    test::expect(near(scores.betweenness[0], 0.0), "no betweenness at the end of a path");
+    test::expect(near(scores.betweenness[1], 3.0 / 6.0), "betweenness 1/2 next to the end");
+    test::expect(near(scores.betweenness[2], 4.0 / 6.0), "betweenness 2/3 in the middle");
+    test::expect(near(scores.closeness[2], 4.0 / 6.0), "closeness 4/6 in the middle");
+    test::expect(near(scores.closeness[0], 4.0 / 10.0), "closeness 4/10 at the end");
+    test::expect(near(scores.harmonic[2], 3.0 / 4.0), "harmonic 3/4 in the middle");
+    test::expect(near(scores.harmonic[0], (1.0 + 1.0 / 2 + 1.0 / 3 + 1.0 / 4) / 4.0),
+                 "harmonic 25/48 at the end");
+}
+
+void disconnected_closeness() {
+    ogdf::Graph graph;
+    test::path(2, graph);
+    test::path(3, graph);
+
+    const auto scores = compute_centrality(graph, {.threads = 1});
+
+    // Wasserman-Faust: r/(n-1) * r/sum with r = 2 reachable vertices.
+    test::expect(near(scores.closeness[3], 2.0 / 4.0 * 2.0 / 2.0),
+                 "closeness scaled by the vertices reachable");
+    test::expect(near(scores.closeness[0], 1.0 / 4.0 * 1.0 / 1.0),
+                 "closeness of the smaller component");
+}
+
+// Splitting sources between threads only changes the summation order.
+void threads_agree(synthetic::topology t) {
+    const auto g = synthetic::generate(t, 1000);
+    ogdf::Graph graph;
+    test::to_ogdf(g, graph);
+
+    const auto single = compute_centrality(graph, {.threads = 1});
+    const auto threaded = compute_centrality(graph, {.threads = 4});
+    const auto all_sources = compute_centrality(graph, {.threads = 3, .samples = 1000});
+
+    std::size_t disagreements = 0;
+
+    for (std::size_t i = 0; i < single.betweenness.size(); i++) {
+        for (const auto* scores : {&threaded, &all_sources}) {
+            if (!near(scores->betweenness[i], single.betweenness[i]) ||
+                !near(scores->closeness[i], single.closeness[i]) ||
+                !near(scores->harmonic[i], single.harmonic[i])) {
+                disagreements++;
+            }
+        }
+    }
+
+    test::expect(disagreements == 0, "threaded scores to match a single thread, " +
+                                         std::to_string(disagreements) + " differ");
+}
+
+// Ranked from the store, hop scores are the graph's, index for index.
+void store_hops() {
+    const auto g = synthetic::generate(synthetic::topology::near_planar, 300);
+    const country_store countries = synthetic::to_store(g);
+    ogdf::Graph graph;
+    test::to_ogdf(g, graph);
+
+    const auto from_graph = compute_centrality(graph, {.threads = 1});
+    const auto from_store = compute_centrality(countries, centrality_weight::hops, {.threads = 1});
+
+    std::size_t disagreements = 0;
+
+    for (std::size_t i = 0; i < countries.size(); i++) {
+        if (!near(from_store.betweenness[i], from_graph.betweenness[i]) ||
+            !near(from_store.closeness[i], from_graph.closeness[i]) ||
+            !near(from_store.harmonic[i], from_graph.harmonic[i])) {
+            disagreements++;
+        }
+    }
+
+    test::expect(disagreements == 0, "store hop scores to match the graph, " +
+                                         std::to_string(disagreements) + " differ");
+}
+
+// A-B-C-D-A with B on the straight line from A to C and D well off it.
+country_store square() {
+    const auto at = [](double latitude, double longitude) {
+        return capital_coordinates{.latitude = latitude, .longitude = longitude};
+    };
+    const std::vector<std::string_view> a{"BB", "DD"};
+    const std::vector<std::string_view> b{"AA", "CC"};
+    const std::vector<std::string_view> c{"BB", "DD"};
+    const std::vector<std::string_view> d{"CC", "AA"};
+
+    country_store countries;
+    countries.add("A", "AA", "a", at(0.0, 0.0), a);
+    countries.add("B", "BB", "b", at(0.0, 1.0), b);
+    countries.add("C", "CC", "c", at(0.0, 2.0), c);
+    countries.add("D", "DD", "d", at(1.5, 1.0), d);
+    countries.link();
+
+    return countries;
+}
+
+void square_scores() {
+    const country_store countries = square();
+
+    const auto weighted =
+        compute_centrality(countries, centrality_weight::capital_distance, {.threads = 1});
+    const auto hops = compute_centrality(countries, centrality_weight::hops, {.threads = 1});
+
+    // Of the 3 pairs of other countries, only A-C routes through B, and only
+    // by distance; by hops it splits between B and D.
+    test::expect(near(weighted.betweenness[1], 1.0 / 3.0), "B on the short route from A to C");
+    test::expect(near(weighted.betweenness[3], 0.0), "D on no shortest route by distance");
+    test::expect(near(hops.betweenness[1], 1.0 / 6.0), "B on half the A-C routes by hops");
+    test::expect(near(hops.betweenness[3], 1.0 / 6.0), "D on half the A-C routes by hops");
+
+    const double ab = spatial::great_circle_km(*countries[0].capital_coords,
+                                               *countries[1].capital_coords);
+    const double ad = spatial::great_circle_km(*countries[0].capital_coords,
+                                               *countries[3].capital_coords);
+
+    // Lengths are rounded to whole metres, hence the looser tolerance.
+    test::expect(near(weighted.harmonic[0], (1.0 / ab + 1.0 / (2 * ab) + 1.0 / ad) / 3.0, 1e-6),
+                 "harmonic centrality of A in km");
+}
+
+// Lexicographic (metres, hops) distances, as the weighted search orders them.
+using route_length = std::pair<double, std::uint32_t>;
+
+constexpr route_length no_route{std::numeric_limits<double>::infinity(), 0};
+
+route_length operator+(route_length a, route_length b) {
+    return {a.first + b.first, a.second + b.second};
+}
+
+// All pairs shortest routes and route counts, then every score from its
+// definition.
+centrality_scores brute_force_weighted(const country_store& countries) {
+    const std::size_t n = countries.size();
+    std::vector<std::vector<route_length>> length(n, std::vector<route_length>(n, no_route));
+
+    const auto border = [&](std::uint32_t u, std::uint32_t v) {
+        const double km = spatial::great_circle_km(*countries[u].capital_coords,
+                                                   *countries[v].capital_coords);
+
+        return route_length{std::round(km * 1000.0), 1};
+    };
+
+    for (std::uint32_t u = 0; u < n; u++) {
+        length[u][u] = {0.0, 0};
+
+        for (const std::uint32_t v : countries.neighbours(u)) {
+            length[u][v] = border(u, v);
+        }
+    }
+
+    for (std::size_t k = 0; k < n; k++) {
+        for (std::size_t i = 0; i < n; i++) {
+            for (std::size_t j = 0; j < n; j++) {
+                if (length[i][k] != no_route && length[k][j] != no_route) {
+                    length[i][j] = std::min(length[i][j], length[i][k] + length[k][j]);
+                }
+            }
+        }
+    }
+
+    std::vector<std::vector<double>> routes(n, std::vector<double>(n, 0.0));
+
+    for (std::uint32_t s = 0; s < n; s++) {
+        std::vector<std::uint32_t> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(),
+                  [&](std::uint32_t a, std::uint32_t b) { return length[s][a] < length[s][b]; });
+
+        routes[s][s] = 1.0;
+
+        for (const std::uint32_t t : order) {
+            for (const std::uint32_t u : countries.neighbours(t)) {
+                if (t != s && length[s][u] != no_route &&
+                    length[s][u] + border(u, t) == length[s][t]) {
+                    routes[s][t] += routes[s][u];
+                }
+            }
+        }
+    }
+
+    centrality_scores scores{std::vector<double>(n, 0.0), std::vector<double>(n, 0.0),
+                             std::vector<double>(n, 0.0)};
+    const double others = static_cast<double>(n - 1);
+
+    for (std::size_t v = 0; v < n; v++) {
+        double reached = 0.0;
+        double km_sum = 0.0;
+
+        for (std::size_t s = 0; s < n; s++) {
+            if (s == v || length[s][v] == no_route) {
+                continue;
+            }
+
+            reached++;
+            km_sum += length[s][v].first / 1000.0;
+            scores.harmonic[v] += 1000.0 / length[s][v].first;
+
+            for (std::size_t t = s + 1; t < n; t++) {
+                if (t != v && length[v][t] != no_route &&
+                    length[s][v] + length[v][t] == length[s][t]) {
+                    scores.betweenness[v] += routes[s][v] * routes[v][t] / routes[s][t];
+                }
+            }
+        }
+
+        scores.betweenness[v] /= others * (others - 1) / 2.0;
+        scores.closeness[v] = km_sum > 0.0 ? (reached / others) * (reached / km_sum) : 0.0;
+        scores.harmonic[v] /= others;
+    }
+
+    return scores;
+}
+
+void weighted_against_brute_force(synthetic::topology t) {
+    const country_store countries = synthetic::to_store(synthetic::generate(t, 80));
+
+    const auto expected = brute_force_weighted(countries);
+    const auto scores =
+        compute_centrality(countries, centrality_weight::capital_distance, {.threads = 2});
+
+    std::size_t disagreements = 0;
+
+    for (std::size_t i = 0; i < countries.size(); i++) {
+        if (!near(scores.betweenness[i], expected.betweenness[i]) ||
+            !near(scores.closeness[i], expected.closeness[i]) ||
+            !near(scores.harmonic[i], expected.harmonic[i])) {
+            disagreements++;
+        }
+    }
+
+    test::expect(disagreements == 0, "weighted scores to match the definitions, " +
+                                         std::to_string(disagreements) + " differ");
+}
+
+void ranking() {
+    const country_store countries = square();
+    const centrality_scores scores{.betweenness = {0.2, 0.5, 0.1, 0.5},
+                                   .closeness = {0.3, 0.1, 0.2, 0.4},
+                                   .harmonic = {0.0, 0.0, 0.0, 0.0}};
+
+    const auto codes = [&](centrality_measure by) {
+        std::string joined;
+
+        for (const auto& c : rank_countries(countries, scores, by)) {
+            joined += std::string(c.iso_code) + " ";
+        }
+
+        return joined;
+    };
+
+    test::expect(codes(centrality_measure::betweenness) == "BB DD AA CC ",
+                 "highest betweenness first, ties in ISO order");
+    test::expect(codes(centrality_measure::closeness) == "DD AA CC BB ",
+                 "highest closeness first");
+    test::expect(codes(centrality_measure::harmonic) == "AA BB CC DD ",
+                 "all tied, in ISO order");
+
+    const auto top = rank_countries(countries, scores, centrality_measure::betweenness).front();
+
+    test::expect(top.name == "B" && top.closeness == 0.1,
+                 "every score and the name to come with the country");
+}
+
+}  // namespace
+
+int main() {
+    test::run("path_scores", path_scores);
+    test::run("disconnected_closeness", disconnected_closeness);
+
+    test::run_per_topology("threads_agree", threads_agree);
+    test::run("store_hops", store_hops);
+    test::run("square_scores", square_scores);
+    test::run_per_topology("weighted_against_brute_force", weighted_against_brute_force);
+    test::run("ranking", ranking);
+
+    return test::result();
+}
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamic_metrics.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_topologies.h"
+
+namespace {
+
+using vertex = dynamic_metrics::vertex;
+using change = dynamic_metrics::change;
+
+// The greedy colouring depends on the order of updates, so only its bound may
+// differ between two routes to the same graph.
+void expect_same(dynamic_metrics::summary incremental, const dynamic_metrics::summary& fresh,
+                 const std::string& what) {
+    test::expect(incremental.chromatic_upper_bound >= incremental.chromatic_lower_bound,
+                 "a colouring with at least as many colours as the largest clique " + what);
+
+    incremental.chromatic_upper_bound = fresh.chromatic_upper_bound;
+
+    test::expect(incremental == fresh, "the metrics of a fresh build " + what);
+}
+
+// The graph the updates should have produced, kept next to the incremental
+// one so batches only refer to vertices that exist when they are applied.
+struct model {
+    std::vector<char> alive;
+    std::set<std::pair<vertex, vertex>> edges;
+
+    // Built from scratch over the live vertices only, renumbered in order, with
+    // the centres mapped back to the original ids.
+    dynamic_metrics::summary fresh() const {
+        std::vector<vertex> compact(alive.size(), 0);
+        std::vector<vertex> original;
+
+        for (vertex v = 0; v < alive.size(); v++) {
+            if (alive[v]) {
+                compact[v] = static_cast<vertex>(original.size());
+                original.push_back(v);
+            }
+        }
+
+        std::vector<std::pair<vertex, vertex>> compact_edges;
+
+        for (const auto& [u, v] : edges) {
+            compact_edges.emplace_back(compact[u], compact[v]);
+        }
+
+        auto summary = dynamic_metrics(original.size(), compact_edges).current();
+
+        for (vertex& center : summary.biggest_component_centers) {
+            center = original[center];
+        }
+
+        return summary;
+    }
+};
+
+std::vector<change> random_batch(model& m, std::mt19937_64& rng) {
+    std::vector<change> batch(std::uniform_int_distribution<std::size_t>(1, 8)(rng));
+
+    const auto any_alive = [&] {
+        std::uniform_int_distribution<vertex> pick(0, static_cast<vertex>(m.alive.size() - 1));
+
+        for (;;) {
+            if (const vertex v = pick(rng); m.alive[v]) {
+                return v;
+            }
+        }
+    };
+
+    for (change& c : batch) {
+        const int roll = std::uniform_int_distribution<int>(0, 99)(rng);
+        const auto live = std::count(m.alive.begin(), m.alive.end(), 1);
+
+        if (roll < 10 || live < 3) {
+            c = {.type = change::kind::insert_node};
+            m.alive.push_back(1);
+        } else if (roll < 20) {
+            c = {.type = change::kind::delete_node, .u = any_alive()};
+            m.alive[c.u] = 0;
+            std::erase_if(m.edges,
+                          [&](const auto& e) { return e.first == c.u || e.second == c.u; });
+        } else if (roll < 60 || m.edges.empty()) {
+            vertex u = any_alive();
+            vertex v = any_alive();
+
+            while (v == u) {
+                v = any_alive();
+            }
+
+            c = {.type = change::kind::insert_edge, .u = u, .v = v};
+            m.edges.insert(std::minmax(u, v));
+        } else {
+            auto it = m.edges.begin();
+            std::advance(it,
+                         std::uniform_int_distribution<std::size_t>(0, m.edges.size() - 1)(rng));
+
+            c = {.type = change::kind::delete_edge, .u = it->second, .v = it->first};
+            m.edges.erase(it);
+        }
+    }
+
+    return batch;
+}
+
+void random_batches(std::size_t number_of_vertices, std::size_t number_of_edges,
+                    std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    model m{.alive = std::vector<char>(number_of_vertices, 1), .edges = {}};
+    std::uniform_int_distribution<vertex> pick(0, static_cast<vertex>(number_of_vertices - 1));
+
+    while (m.edges.size() < number_of_edges) {
+        const vertex u = pick(rng);
+        const vertex v = pick(rng);
+
+        if (u != v) {
+            m.edges.insert(std::minmax(u, v));
+        }
+    }
+
+    dynamic_metrics dynamic(number_of_vertices,
+                            std::vector<std::pair<vertex, vertex>>(m.edges.begin(), m.edges.end()));
+
+    expect_same(dynamic.current(), m.fresh(), "after the initial build");
+
+    for (int round = 0; round < 300; round++) {
+        const auto batch = random_batch(m, rng);
+        const auto applied = dynamic.apply(batch);
+
+        test::expect(applied.has_value(), "a valid batch to apply");
+
+        if (!applied) {
+            return;
+        }
+
+        expect_same(*applied, m.fresh(), "after batch " + std::to_string(round));
+
+        if (test::failures > 0) {
+            return;
+        }
+    }
+}
+
+void sparse() { random_batches(40, 50, 1); }
+
+void dense() { random_batches(25, 120, 2); }
+
+void border_toggle(synthetic::topology t) {
+    const auto g = synthetic::generate(t, 500);
+    dynamic_metrics dynamic(g.coords.size(), g.edges);
+    const dynamic_metrics::summary initial = dynamic.current();
+
+    for (const auto& [u, v] : g.edges) {
+        const change close{.type = change::kind::delete_edge, .u = u, .v = v};
+        const change reopen{.type = change::kind::insert_edge, .u = u, .v = v};
+
+        dynamic.apply({&close, 1});
+        dynamic.apply({&reopen, 1});
+    }
+
+    expect_same(dynamic.current(), initial, "after closing and reopening every border");
+}
+
+void errors() {
+    const std::vector<std::pair<vertex, vertex>> edges{{0, 1}, {1, 2}};
+    dynamic_metrics dynamic(3, edges);
+    const auto before = dynamic.current();
+
+    const std::vector<change> unknown{
+        {.type = change::kind::delete_node, .u = 2},
+        {.type = change::kind::insert_edge, .u = 0, .v = 2},
+    };
+    const auto rejected = dynamic.apply(unknown);
+
+    test::expect(!rejected && rejected.error().error_code ==
+                                  dynamic_metrics::error::code::unknown_vertex &&
+                     rejected.error().change_index == 1,
+                 "a deleted vertex to be unknown later in the batch");
+
+    const change loop{.type = change::kind::insert_edge, .u = 1, .v = 1};
+    const auto looped = dynamic.apply({&loop, 1});
+
+    test::expect(!looped && looped.error().error_code == dynamic_metrics::error::code::self_loop,
+                 "a self loop to be rejected");
+    test::expect(dynamic.current() == before, "a rejected batch to leave the graph untouched");
+}
+
+}  // namespace
+
+int main() {
+    test::run("random_batches/sparse", sparse);
+    test::run("random_batches/dense", dense);
+
+    test::run_per_topology("border_toggle", border_toggle);
+
+    test::run("errors", errors);
+
+    return test::result();
+}
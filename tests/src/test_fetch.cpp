@@ -0,0 +1,327 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fetch.h"
+#include "replay_server.h"
+#include "test_common.h"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr int max_attempts = 6;
+
+const nlohmann::json& region_cache() {
+    static const nlohmann::json cache = [] {
+        std::ifstream file(REGION_FIXTURE_PATH);
+        return nlohmann::json::parse(file);
+    }();
+
+    return cache;
+}
+
+struct run_result {
+    std::expected<std::vector<country>, fetch::error> countries;
+    std::size_t region_size;
+    replay::stats restcountries_server;
+    replay::stats geodatasource_server;
+    fetch::quota_usage restcountries;
+    fetch::quota_usage geodatasource;
+};
+
+// Separate servers stand in for the two hosts so the scheduler keeps a rate
+// limiter per host, as it does against the real APIs.
+run_result fetch_region(const replay::fixtures& fixtures, const replay::fault_profile& faults,
+                        std::chrono::milliseconds timeout = 30s) {
+    replay::server restcountries_server(fixtures, faults);
+    replay::server geodatasource_server(fixtures, faults);
+
+    const fetch::endpoints urls{.restcountries = restcountries_server.base_url(),
+                                .geodatasource = geodatasource_server.base_url(),
+                                .timeout = timeout};
+
+    fetch::request_scheduler scheduler(
+        8, {.max_attempts = max_attempts, .base_delay = 10ms, .max_delay = 200ms});
+
+    fetch::configure_rate_limits(
+        scheduler, urls,
+        {.restcountries = {.requests_per_second = 500.0, .burst = 50.0, .quota = 0},
+         .geodatasource = {.requests_per_second = 250.0, .burst = 25.0, .quota = 0}});
+
+    const auto codes = fetch::fetch_region_codes(scheduler, "europe", urls);
+
+    test::expect(codes.has_value(), "region codes to be fetched");
+
+    if (!codes) {
+        return run_result{.countries = std::unexpected(codes.error()),
+                          .region_size = 0,
+                          .restcountries_server = restcountries_server.statistics(),
+                          .geodatasource_server = geodatasource_server.statistics(),
+                          .restcountries = scheduler.usage(urls.restcountries),
+                          .geodatasource = scheduler.usage(urls.geodatasource)};
+    }
+
+    auto countries = fetch::fetch_countries(scheduler, "replay", codes.value(), urls);
+
+    return run_result{.countries = std::move(countries),
+                      .region_size = codes.value().size(),
+                      .restcountries_server = restcountries_server.statistics(),
+                      .geodatasource_server = geodatasource_server.statistics(),
+                      .restcountries = scheduler.usage(urls.restcountries),
+                      .geodatasource = scheduler.usage(urls.geodatasource)};
+}
+
+void expect_complete(const run_result& r) {
+    test::expect(r.countries.has_value(), "a complete result");
+
+    if (!r.countries) {
+        return;
+    }
+
+    const auto& cache = region_cache();
+
+    test::expect(r.region_size == cache.size(), "every country of the region to be listed");
+    test::expect(r.countries->size() == cache.size(), "every country to be fetched");
+
+    for (const auto& c : *r.countries) {
+        if (!cache.contains(c.iso_code)) {
+            test::expect(false, "only countries of the region, got " + c.iso_code);
+            continue;
+        }
+
+        const auto& cached = cache[c.iso_code];
+
+        test::expect(c.name == cached["name"], "the recorded name of " + c.iso_code);
+        test::expect(c.capital == cached["capital"], "the recorded capital of " + c.iso_code);
+        test::expect(c.neighboring_countries_iso ==
+                         cached["neighboring_countries_iso"].get<std::vector<std::string>>(),
+                     "the recorded neighbours of " + c.iso_code);
+    }
+}
+
+// Every failed attempt is retried while attempts remain, and nothing else is.
+void expect_retried_failures(const run_result& r) {
+    const auto failures = [](const replay::stats& s) {
+        return s.throttled + s.server_errors + s.timeouts;
+    };
+
+    test::expect(r.restcountries.retries == failures(r.restcountries_server),
+                 "one restcountries retry per failed attempt");
+    test::expect(r.geodatasource.retries == failures(r.geodatasource_server),
+                 "one geodatasource retry per failed attempt");
+    test::expect(r.restcountries.throttled == r.restcountries_server.throttled,
+                 "every restcountries 429 to be counted as throttled");
+    test::expect(r.geodatasource.throttled == r.geodatasource_server.throttled,
+                 "every geodatasource 429 to be counted as throttled");
+    test::expect(r.restcountries.requests == r.restcountries_server.requests,
+                 "one restcountries request per server hit");
+    test::expect(r.geodatasource.requests == r.geodatasource_server.requests,
+                 "one geodatasource request per server hit");
+}
+
+void clean() {
+    const auto r =
+        fetch_region(replay::fixtures_from_region_cache(region_cache(), "europe"), {});
+
+    expect_complete(r);
+    expect_retried_failures(r);
+    test::expect(r.restcountries.retries + r.geodatasource.retries == 0, "no retries");
+}
+
+void throttled() {
+    const auto r = fetch_region(replay::fixtures_from_region_cache(region_cache(), "europe"),
+                                {.throttle_rate = 0.1, .retry_after = 1s});
+
+    expect_complete(r);
+    expect_retried_failures(r);
+    test::expect(r.restcountries_server.throttled + r.geodatasource_server.throttled > 0,
+                 "the profile to throttle some requests");
+}
+
+void server_errors() {
+    const auto r = fetch_region(replay::fixtures_from_region_cache(region_cache(), "europe"),
+                                {.server_error_rate = 0.2});
+
+    expect_complete(r);
+    expect_retried_failures(r);
+    test::expect(r.restcountries_server.server_errors + r.geodatasource_server.server_errors >
+                     0,
+                 "the profile to fail some requests");
+}
+
+void timeouts() {
+    const auto r = fetch_region(replay::fixtures_from_region_cache(region_cache(), "europe"),
+                                {.timeout_rate = 0.1, .stall = 1s}, 250ms);
+
+    expect_complete(r);
+    expect_retried_failures(r);
+    test::expect(r.restcountries_server.timeouts + r.geodatasource_server.timeouts > 0,
+                 "the profile to stall some requests");
+}
+
+void incomplete() {
+    auto fixtures = replay::fixtures_from_region_cache(region_cache(), "europe");
+    const std::vector<std::string> failing{"DE", "FR"};
+
+    for (const auto& iso_code : failing) {
+        fixtures.insert_or_assign(replay::request_key("/v3.1/alpha/" + iso_code, ""),
+                                  replay::response{.status = 503, .body = "{}"});
+    }
+
+    const auto r = fetch_region(fixtures, {});
+
+    test::expect(!r.countries.has_value(), "an error for the failing countries");
+
+    if (r.countries) {
+        return;
+    }
+
+    const auto& error = r.countries.error();
+
+    test::expect(error.error_code == fetch::error::code::incomplete_result,
+                 "an incomplete_result error");
+    test::expect(error.status_code == 503, "the last failure's status code");
+    test::expect(error.message == "Fetched " + std::to_string(r.region_size - 2) + " of " +
+                                      std::to_string(r.region_size) + " countries, missing: " +
+                                      failing[0] + ", " + failing[1],
+                 "the missing countries in region order, got: " + error.message);
+
+    const std::size_t retries = failing.size() * (max_attempts - 1);
+
+    test::expect(r.restcountries.retries == retries, "every attempt of a failing country");
+    test::expect(r.geodatasource.retries == 0, "no geodatasource retries");
+    test::expect(r.restcountries_server.requests == 1 + r.region_size + retries,
+                 "the region, every country, and the retries to reach the server");
+}
+
+// A 404 is as much a failure as a 5xx: the country is reported missing, not
+// left out of a region that would then be cached as complete.
+void not_found() {
+    auto fixtures = replay::fixtures_from_region_cache(region_cache(), "europe");
+
+    fixtures.insert_or_assign(replay::request_key("/v3.1/alpha/IT", ""),
+                              replay::response{.status = 404, .body = "{}"});
+    fixtures.insert_or_assign(
+        replay::request_key("/v2/neighboring-countries", "country_code=PL&format=json"),
+        replay::response{.status = 404, .body = "{}"});
+
+    const auto r = fetch_region(fixtures, {});
+
+    test::expect(!r.countries.has_value(), "an error for the countries not found");
+
+    if (r.countries) {
+        return;
+    }
+
+    const auto& error = r.countries.error();
+
+    test::expect(error.error_code == fetch::error::code::incomplete_result,
+                 "an incomplete_result error");
+    test::expect(error.message.ends_with("missing: IT, PL"),
+                 "both countries to be missing, got: " + error.message);
+    test::expect(r.restcountries.retries + r.geodatasource.retries == 0,
+                 "no retries for a 404");
+}
+
+// A malformed answer ends the call at once, and the requests still queued
+// behind it are never sent.
+void hard_error_cancels() {
+    const auto& cache = region_cache();
+    auto fixtures = replay::fixtures_from_region_cache(cache, "europe");
+
+    fixtures.insert_or_assign(replay::request_key("/v3.1/alpha/" + cache.begin().key(), ""),
+                              replay::response{.status = 200, .body = "not json"});
+
+    replay::server restcountries_server(fixtures);
+    replay::server geodatasource_server(fixtures);
+
+    const fetch::endpoints urls{.restcountries = restcountries_server.base_url(),
+                                .geodatasource = geodatasource_server.base_url(),
+                                .timeout = 30s};
+
+    fetch::request_scheduler scheduler(8);
+
+    fetch::configure_rate_limits(
+        scheduler, urls,
+        {.restcountries = {.requests_per_second = 20.0, .burst = 1.0, .quota = 0},
+         .geodatasource = {.requests_per_second = 20.0, .burst = 1.0, .quota = 0}});
+
+    const auto codes = fetch::fetch_region_codes(scheduler, "europe", urls);
+
+    test::expect(codes.has_value(), "region codes to be fetched");
+
+    if (!codes) {
+        return;
+    }
+
+    const auto countries = fetch::fetch_countries(scheduler, "replay", *codes, urls);
+
+    test::expect(!countries && countries.error().error_code == fetch::error::code::parse_error,
+                 "the malformed country to fail the call");
+
+    const auto sent = [&] {
+        return restcountries_server.statistics().requests +
+               geodatasource_server.statistics().requests;
+    };
+
+    const std::size_t at_return = sent();
+
+    std::this_thread::sleep_for(500ms);
+
+    // At most the one request per host that was already on the wire.
+    test::expect(sent() <= at_return + 2, "no queued request to be sent after the error");
+    test::expect(sent() < 1 + 2 * codes->size(), "the rest of the region to stay unfetched");
+}
+
+void rate_limits() {
+    fetch::request_scheduler scheduler(1);
+
+    test::expect(!scheduler.set_rate_limit("host", {.requests_per_second = 0.0}),
+                 "a zero rate to be rejected");
+    test::expect(!scheduler.set_rate_limit("host", {.requests_per_second = -1.0}),
+                 "a negative rate to be rejected");
+    test::expect(!scheduler.set_rate_limit(
+                     "host", {.requests_per_second = std::numeric_limits<double>::infinity()}),
+                 "an infinite rate to be rejected");
+    test::expect(!scheduler.set_rate_limit("host", {.requests_per_second = 10.0, .burst = 0.5}),
+                 "a burst below one request to be rejected");
+    test::expect(scheduler.set_rate_limit("host", {.requests_per_second = 10.0, .burst = 1.0}),
+                 "a rate with a burst of one request to be accepted");
+
+    const auto configured = fetch::configure_rate_limits(
+        scheduler, {}, {.geodatasource = {.requests_per_second = 5.0, .burst = 0.0}});
+
+    test::expect(!configured &&
+                     configured.error().error_code == fetch::error::code::invalid_rate_limit,
+                 "an invalid geodatasource limit to fail the configuration");
+
+    // The rejected limit left the host's bucket usable.
+    auto answered = scheduler.submit("host", fetch::priority::normal,
+                                     [] { return fetch::http_response{.status_code = 200}; });
+
+    test::expect(answered.wait_for(5s) == std::future_status::ready &&
+                     answered.get().status_code == 200,
+                 "a request to go through after a rejected limit");
+}
+
+}  // namespace
+
+int main() {
+    test::run("clean", clean);
+    test::run("throttled", throttled);
+    test::run("server_errors", server_errors);
+    test::run("timeouts", timeouts);
+    test::run("incomplete", incomplete);
+    test::run("not_found", not_found);
+    test::run("hard_error_cancels", hard_error_cancels);
+    test::run("rate_limits", rate_limits);
+
+    return test::result();
+}
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "country_store.h"
+#include "json_file.h"
+#include "test_common.h"
+
+namespace {
+
+std::expected<country_store, json_file::error_info> read_text(std::string_view text) {
+    const auto path = std::filesystem::temp_directory_path() / "test_json_file.json";
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << text;
+    }
+
+    auto result = json_file::read_countries(path.string());
+    std::filesystem::remove(path);
+
+    return result;
+}
+
+void region_file() {
+    const auto countries = json_file::read_countries(REGION_FIXTURE_PATH);
+
+    test::expect(countries.has_value(), "the checked-in region to load");
+
+    if (!countries) {
+        return;
+    }
+
+    bool any_coords = false;
+
+    for (const auto& entry : countries->entries()) {
+        any_coords |= entry.capital_coords.has_value();
+    }
+
+    test::expect(!countries->empty(), "countries in the region");
+    test::expect(!any_coords, "no capital coordinates where the file has none");
+
+    const nlohmann::json written = *countries;
+
+    test::expect(!written.begin()->contains("capital_coords"),
+                 "missing coordinates to stay missing when written back");
+}
+
+void coordinates() {
+    const auto countries = read_text(R"({
+        "AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+               "capital_coords": {"latitude": 42.5, "longitude": 1.52},
+               "neighboring_countries_iso": ["ES", "FR"], "population": {"total": 80000}},
+        "ES": {"name": "Spain", "iso_code": "ES", "capital": "Madrid",
+               "capital_coords": null, "neighboring_countries_iso": ["AD"]},
+        "FR": {"name": "France", "iso_code": "FR", "capital": "Paris",
+               "neighboring_countries_iso": ["AD"]}
+    })");
+
+    test::expect(countries.has_value(), "a valid region to load");
+
+    if (!countries) {
+        return;
+    }
+
+    const auto& andorra = (*countries)[*countries->find("AD")];
+
+    test::expect(andorra.capital_coords && andorra.capital_coords->latitude == 42.5 &&
+                     andorra.capital_coords->longitude == 1.52,
+                 "the recorded coordinates");
+    test::expect(!(*countries)[*countries->find("ES")].capital_coords,
+                 "null coordinates to be missing");
+    test::expect(!(*countries)[*countries->find("FR")].capital_coords,
+                 "absent coordinates to be missing");
+    test::expect(countries->neighbours(*countries->find("AD")).size() == 2,
+                 "unknown fields to be skipped");
+    test::expect(countries->border_km(*countries->find("AD")).empty(),
+                 "no border lengths in a region cache");
+}
+
+void malformed() {
+    constexpr std::string_view documents[] = {
+        R"([])",
+        R"("europe")",
+        R"({"AD": "Andorra"})",
+        R"({"AD": ["Andorra"]})",
+        R"({"AD": {"name": "Andorra", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": 1, "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": null,
+                   "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": "ES"}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": ["ES", 4]}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": [["ES"]]}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "capital_coords": {"latitude": 42.5},
+                   "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "capital_coords": {"latitude": "42.5", "longitude": 1.52},
+                   "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "capital_coords": [42.5, 1.52], "neighboring_countries_iso": []}})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": []})",
+        R"({"AD": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                   "neighboring_countries_iso": []},
+            "AND": {"name": "Andorra", "iso_code": "AD", "capital": "Andorra la Vella",
+                    "neighboring_countries_iso": []}})",
+    };
+
+    for (const auto document : documents) {
+        const auto result = read_text(document);
+
+        test::expect(!result.has_value() &&
+                         result.error().error_code == json_file::error_info::code::failed_parsing,
+                     "failed_parsing for " + std::string(document));
+    }
+}
+
+}  // namespace
+
+int main() {
+    test::run("region_file", region_file);
+    test::run("coordinates", coordinates);
+    test::run("malformed", malformed);
+
+    return test::result();
+}
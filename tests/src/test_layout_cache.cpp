@@ -0,0 +1,125 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "layout_cache.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_graphs.h"
+#include "visual.h"
+
+namespace {
+
+std::string cache_path(const std::string& name) {
+    const auto path = std::filesystem::temp_directory_path() / ("test_layout_cache_" + name);
+    std::filesystem::remove(path);
+
+    return path.string();
+}
+
+ogdf::NodeArray<std::string> node_keys(const ogdf::Graph& graph,
+                                       const std::vector<ogdf::node>& nodes) {
+    ogdf::NodeArray<std::string> keys(graph);
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        keys[nodes[i]] = synthetic::node_key(static_cast<std::uint32_t>(i));
+    }
+
+    return keys;
+}
+
+bool outcome_is(const std::expected<layout_cache::outcome, json_file::error_info>& result,
+                layout_cache::outcome expected) {
+    return result.has_value() && *result == expected;
+}
+
+void reuse_and_warm_start() {
+    const auto g = synthetic::generate(synthetic::topology::planar, 200);
+    const std::string path = cache_path("reuse.json");
+
+    ogdf::Graph graph;
+    const auto nodes = test::to_ogdf(g, graph);
+    ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+    const auto keys = node_keys(graph, nodes);
+
+    test::expect(outcome_is(layout_cache::layout(graph_attribute, keys, path),
+                            layout_cache::outcome::computed),
+                 "a full layout without a cache");
+    test::expect(outcome_is(layout_cache::layout(graph_attribute, keys, path),
+                            layout_cache::outcome::reused),
+                 "an unchanged graph to reuse the cached layout");
+
+    ogdf::Graph changed;
+    const auto changed_nodes = test::to_ogdf(g, changed);
+    ogdf::GraphAttributes changed_attribute(changed, graph_attribute_flags);
+    changed.delEdge(*changed.edges.begin());
+
+    const auto changed_keys = node_keys(changed, changed_nodes);
+
+    test::expect(outcome_is(layout_cache::layout(changed_attribute, changed_keys, path),
+                            layout_cache::outcome::warm_started),
+                 "a graph missing one border to start from the cached layout");
+
+    std::filesystem::remove(path);
+}
+
+// Georgia the country and Georgia the US state in one drawing: the labels
+// repeat, the codes do not.
+void shared_names() {
+    const std::string path = cache_path("shared_names.json");
+
+    ogdf::Graph graph;
+    const auto nodes = test::path(4, graph);
+    ogdf::GraphAttributes graph_attribute(graph, graph_attribute_flags);
+    ogdf::NodeArray<std::string> keys(graph);
+    const std::vector<std::string> codes{"GE", "RU", "US-GA", "US-AL"};
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        keys[nodes[i]] = codes[i];
+        graph_attribute.label(nodes[i]) = i == 0 || i == 2 ? "Georgia" : "Neighbour";
+    }
+
+    layout_cache::layout(graph_attribute, keys, path);
+
+    std::vector<std::pair<double, double>> drawn;
+
+    for (const ogdf::node v : nodes) {
+        drawn.emplace_back(graph_attribute.x(v), graph_attribute.y(v));
+        graph_attribute.x(v) = 0.0;
+        graph_attribute.y(v) = 0.0;
+    }
+
+    graph_attribute.label(nodes[1]) = "Russia";
+
+    test::expect(outcome_is(layout_cache::layout(graph_attribute, keys, path),
+                            layout_cache::outcome::reused),
+                 "a renamed country to reuse the cached layout");
+
+    bool restored = true;
+
+    for (std::size_t i = 0; i < nodes.size(); i++) {
+        restored = restored && graph_attribute.x(nodes[i]) == drawn[i].first &&
+                   graph_attribute.y(nodes[i]) == drawn[i].second;
+    }
+
+    test::expect(drawn[0] != drawn[2], "the two Georgias to be drawn apart");
+    test::expect(restored, "every country back at its own cached position");
+
+    std::filesystem::remove(path);
+}
+
+}  // namespace
+
+int main() {
+    test::run("reuse_and_warm_start", reuse_and_warm_start);
+    test::run("shared_names", shared_names);
+
+    return test::result();
+}
@@ -0,0 +1,135 @@
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "neighbourhood_function.h"
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_graphs.h"
+#include "test_topologies.h"
+
+namespace {
+
+constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+
+// Pair counts and eccentricities from a BFS out of every vertex.
+neighbourhood_function exact_neighbourhood_function(const ogdf::Graph& graph) {
+    const auto n = static_cast<std::size_t>(graph.maxNodeIndex() + 1);
+    std::vector<std::vector<std::uint32_t>> adjacent(n);
+
+    for (ogdf::edge e : graph.edges) {
+        adjacent[e->source()->index()].push_back(e->target()->index());
+        adjacent[e->target()->index()].push_back(e->source()->index());
+    }
+
+    neighbourhood_function nf;
+    nf.vertices = static_cast<std::size_t>(graph.numberOfNodes());
+    nf.eccentricity.assign(n, 0);
+
+    std::vector<std::size_t> at_distance;
+
+    for (ogdf::node source : graph.nodes) {
+        std::vector<std::uint32_t> distance(n, unreached);
+        std::queue<std::uint32_t> queue;
+
+        distance[source->index()] = 0;
+        queue.push(source->index());
+
+        while (!queue.empty()) {
+            const std::uint32_t v = queue.front();
+            queue.pop();
+
+            if (at_distance.size() <= distance[v]) {
+                at_distance.resize(distance[v] + 1, 0);
+            }
+
+            at_distance[distance[v]]++;
+            nf.eccentricity[source->index()] = distance[v];
+
+            for (const std::uint32_t u : adjacent[v]) {
+                if (distance[u] == unreached) {
+                    distance[u] = distance[v] + 1;
+                    queue.push(u);
+                }
+            }
+        }
+    }
+
+    double pairs = 0.0;
+
+    for (const std::size_t count : at_distance) {
+        pairs += static_cast<double>(count);
+        nf.pairs.push_back(pairs);
+    }
+
+    return nf;
+}
+
+bool contains(const interval_estimate& estimate, double value) {
+    return estimate.low <= value && value <= estimate.high;
+}
+
+void path_iterations() {
+    ogdf::Graph graph;
+    test::path(20, graph);
+
+    const auto nf = approximate_neighbourhood_function(graph, {.threads = 1});
+
+    test::expect(nf.pairs.front() == 20.0, "one self pair per vertex");
+    test::expect(nf.pairs.size() - 1 <= 19, "no more iterations than the diameter");
+    test::expect(nf.eccentricity[0] <= 19 && nf.eccentricity[10] <= 10,
+                 "eccentricities no larger than the exact ones");
+}
+
+void against_exact(synthetic::topology t) {
+    const auto g = synthetic::generate(t, 500);
+    ogdf::Graph graph;
+    test::to_ogdf(g, graph);
+
+    const auto exact = exact_neighbourhood_function(graph);
+    const auto nf = approximate_neighbourhood_function(graph, {.threads = 1});
+    const auto threaded = approximate_neighbourhood_function(graph, {.threads = 4});
+
+    // Counters only grow while some ball does, so the iterations never
+    // outnumber the diameter.
+    test::expect(nf.pairs.size() <= exact.pairs.size(),
+                 "no more iterations than the diameter, " + std::to_string(nf.pairs.size() - 1) +
+                     " > " + std::to_string(exact.pairs.size() - 1));
+    test::expect(nf.pairs.front() == exact.pairs.front(), "exact self pairs");
+    test::expect(std::ranges::is_sorted(nf.pairs), "pair counts that never decrease");
+
+    bool within_eccentricity = true;
+
+    for (ogdf::node v : graph.nodes) {
+        within_eccentricity &= nf.eccentricity[v->index()] <= exact.eccentricity[v->index()];
+    }
+
+    test::expect(within_eccentricity, "eccentricities no larger than the exact ones");
+
+    const double diameter = effective_diameter(exact).value;
+    const double distance = average_distance(exact).value;
+
+    test::expect(contains(effective_diameter(nf), diameter),
+                 "the effective diameter " + std::to_string(diameter) + " within the bounds");
+    test::expect(contains(average_distance(nf), distance),
+                 "the average distance " + std::to_string(distance) + " within the bounds");
+
+    test::expect(threaded.pairs == nf.pairs && threaded.eccentricity == nf.eccentricity,
+                 "the same estimate on any number of threads");
+}
+
+}  // namespace
+
+int main() {
+    test::run("path_iterations", path_iterations);
+
+    test::run_per_topology("against_exact", against_exact);
+
+    return test::result();
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "json_file.h"
+#include "region_data.h"
+#include "test_common.h"
+
+namespace {
+
+void lookup() {
+    test::expect(region_data::find("europe") != nullptr, "europe to be embedded");
+    test::expect(region_data::find("atlantis") == nullptr, "no region that was not embedded");
+}
+
+// The tables stand in for the region file, so a store built from either must
+// be the same country for country.
+void matches_region_file() {
+    const region_data::region* embedded = region_data::find("europe");
+    const auto from_file = json_file::read_countries(REGION_FIXTURE_PATH);
+
+    test::expect(from_file.has_value(), "the region file to load");
+
+    if (embedded == nullptr || !from_file) {
+        return;
+    }
+
+    const country_store from_tables = region_data::to_store(*embedded);
+
+    test::expect(from_tables.size() == from_file->size(), "as many countries as the file");
+
+    if (from_tables.size() != from_file->size()) {
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < from_tables.size(); i++) {
+        const auto& a = (*from_file)[i];
+        const auto& b = from_tables[i];
+        const std::string code(a.code);
+
+        test::expect(a.name == b.name && a.code == b.code && a.capital == b.capital,
+                     "the file's name, code and capital for " + code);
+        test::expect(a.capital_coords.has_value() == b.capital_coords.has_value() &&
+                         (!a.capital_coords ||
+                          (a.capital_coords->latitude == b.capital_coords->latitude &&
+                           a.capital_coords->longitude == b.capital_coords->longitude)),
+                     "the file's capital coordinates for " + code);
+        test::expect(from_file->to_country(i).neighboring_countries_iso ==
+                         from_tables.to_country(i).neighboring_countries_iso,
+                     "the file's neighbour codes for " + code);
+
+        const auto linked_file = from_file->neighbours(i);
+        const auto linked_tables = from_tables.neighbours(i);
+
+        test::expect(std::ranges::equal(linked_file, linked_tables),
+                     "the neighbours linked from the file for " + code);
+        test::expect(from_tables.find(b.code) == i, "the code to find " + code);
+    }
+}
+
+}  // namespace
+
+int main() {
+    test::run("lookup", lookup);
+    test::run("matches_region_file", matches_region_file);
+
+    return test::result();
+}
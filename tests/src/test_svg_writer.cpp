@@ -0,0 +1,231 @@
+#include <ogdf/basic/Graph.h>
+#include <ogdf/basic/GraphAttributes.h>
+#include <zlib.h>
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "svg_writer.h"
+#include "test_common.h"
+
+namespace {
+
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+std::string write_drawing(const ogdf::GraphAttributes& ga, const svg::options& opts = {}) {
+    const auto path = std::filesystem::temp_directory_path() / "test_svg_writer.svg";
+    const auto written = svg::write(ga, path.string(), opts);
+
+    test::expect(written.has_value(), "the drawing to be written");
+
+    std::string text = read_file(path);
+    std::filesystem::remove(path);
+
+    return text;
+}
+
+std::size_t occurrences(const std::string& text, const std::string& needle) {
+    std::size_t found = 0;
+
+    for (auto at = text.find(needle); at != std::string::npos;
+         at = text.find(needle, at + needle.size())) {
+        found++;
+    }
+
+    return found;
+}
+
+ogdf::node add_node(ogdf::Graph& graph, ogdf::GraphAttributes& ga, double x, double y) {
+    const ogdf::node v = graph.newNode();
+    ga.x(v) = x;
+    ga.y(v) = y;
+    ga.width(v) = 20.0;
+    ga.height(v) = 20.0;
+
+    return v;
+}
+
+void plain() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, ogdf::GraphAttributes::nodeGraphics |
+                                        ogdf::GraphAttributes::edgeGraphics);
+
+    add_node(graph, ga, 12.345, -6.5);
+
+    const std::string text = write_drawing(ga);
+
+    test::expect(text.find("x=\"2.35\" y=\"-16.50\"") != std::string::npos,
+                 "two decimals for an ordinary position");
+}
+
+void huge() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, ogdf::GraphAttributes::nodeGraphics |
+                                        ogdf::GraphAttributes::edgeGraphics);
+
+    // Enough of them that some land at the end of the output buffer.
+    constexpr std::size_t count = 500;
+
+    for (std::size_t i = 0; i < count; i++) {
+        add_node(graph, ga, 1e300, 0.0);
+    }
+
+    const std::string text = write_drawing(ga);
+
+    std::array<char, 400> digits;
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), 1e300 - 10.0,
+                                   std::chars_format::fixed, 2)
+                         .ptr;
+
+    const std::string position = "x=\"" + std::string(digits.data(), end) + "\"";
+
+    test::expect(occurrences(text, position) == count,
+                 "every digit of positions too long for the reserved space");
+    test::expect(text.ends_with("</svg>\n"), "the rest of the drawing after it");
+}
+
+void non_finite() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, ogdf::GraphAttributes::nodeGraphics |
+                                        ogdf::GraphAttributes::edgeGraphics);
+
+    add_node(graph, ga, std::numeric_limits<double>::quiet_NaN(), 0.0);
+    add_node(graph, ga, std::numeric_limits<double>::infinity(), 0.0);
+
+    const std::string text = write_drawing(ga);
+
+    test::expect(text.find("nan") == std::string::npos && text.find("inf") == std::string::npos,
+                 "no nan or inf in the drawing");
+}
+
+// A triangle of labelled nodes and borders, all three nodes in one spot, and
+// a fourth node with a border of its own far away.
+void add_cluster(ogdf::Graph& graph, ogdf::GraphAttributes& ga) {
+    const ogdf::node a = add_node(graph, ga, 0.0, 0.0);
+    const ogdf::node b = add_node(graph, ga, 1.0, 1.0);
+    const ogdf::node c = add_node(graph, ga, 2.0, 2.0);
+    const ogdf::node far = add_node(graph, ga, 500.0, 500.0);
+
+    ga.label(a) = "A";
+    ga.label(b) = "B";
+    ga.label(c) = "C";
+    ga.label(far) = "Far";
+
+    for (const auto& [u, v] : {std::pair(a, b), std::pair(b, c), std::pair(c, a),
+                              std::pair(a, far), std::pair(b, far)}) {
+        ga.label(graph.newEdge(u, v)) = "border";
+    }
+}
+
+constexpr long labelled = ogdf::GraphAttributes::nodeGraphics |
+                          ogdf::GraphAttributes::edgeGraphics |
+                          ogdf::GraphAttributes::nodeLabel | ogdf::GraphAttributes::edgeLabel;
+
+void gzip() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, labelled);
+    add_cluster(graph, ga);
+
+    const std::string plain_text = write_drawing(ga);
+    const auto directory = std::filesystem::temp_directory_path();
+
+    const std::array named_options{
+        std::pair("test_svg_writer.svgz", svg::options{}),
+        std::pair("test_svg_writer.svg", svg::options{.gzip = true}),
+    };
+
+    for (const auto& [name, opts] : named_options) {
+        const auto path = directory / name;
+
+        test::expect(svg::write(ga, path.string(), opts).has_value(),
+                     std::string("the drawing to be written to ") + name);
+
+        const std::string raw = read_file(path);
+
+        test::expect(raw.size() > 2 && raw[0] == '\x1f' && raw[1] == '\x8b',
+                     std::string("a gzip header in ") + name);
+
+        std::string text;
+        gzFile file = gzopen(path.string().c_str(), "rb");
+        std::array<char, 4096> chunk;
+
+        while (file != nullptr) {
+            const int read = gzread(file, chunk.data(), chunk.size());
+
+            if (read <= 0) {
+                break;
+            }
+
+            text.append(chunk.data(), static_cast<std::size_t>(read));
+        }
+
+        if (file != nullptr) {
+            gzclose(file);
+        }
+
+        std::filesystem::remove(path);
+
+        test::expect(text == plain_text,
+                     std::string("the uncompressed drawing inside ") + name);
+    }
+}
+
+void edge_label_limit() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, labelled);
+    add_cluster(graph, ga);
+
+    test::expect(occurrences(write_drawing(ga, {.edge_label_limit = 5}), ">border<") == 5,
+                 "every edge label up to the limit");
+    test::expect(occurrences(write_drawing(ga, {.edge_label_limit = 4}), ">border<") == 0,
+                 "no edge labels above the limit");
+    test::expect(occurrences(write_drawing(ga, {.edge_labels = false}), ">border<") == 0,
+                 "no edge labels when they are turned off");
+}
+
+void merge_node_limit() {
+    ogdf::Graph graph;
+    ogdf::GraphAttributes ga(graph, labelled);
+    add_cluster(graph, ga);
+
+    const std::string full = write_drawing(ga, {.merge_node_limit = 4});
+
+    test::expect(occurrences(full, "<rect ") == 4, "every node up to the limit");
+    test::expect(occurrences(full, "<path ") == 5, "every edge up to the limit");
+
+    const std::string merged = write_drawing(ga, {.merge_node_limit = 3});
+
+    test::expect(occurrences(merged, "<rect ") == 2, "one node per occupied grid cell");
+    test::expect(merged.find(">A (+2)<") != std::string::npos,
+                 "the first node of a cell to stand for the others");
+    test::expect(
+        merged.find(">B<") == std::string::npos && merged.find(">C<") == std::string::npos,
+        "no labels for the merged nodes");
+    test::expect(occurrences(merged, "<path ") == 1,
+                 "borders inside a cell dropped and parallel ones drawn once");
+}
+
+}  // namespace
+
+int main() {
+    test::run("plain", plain);
+    test::run("huge", huge);
+    test::run("non_finite", non_finite);
+    test::run("gzip", gzip);
+    test::run("edge_label_limit", edge_label_limit);
+    test::run("merge_node_limit", merge_node_limit);
+
+    return test::result();
+}
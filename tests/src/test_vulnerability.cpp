@@ -0,0 +1,269 @@
+#include <ogdf/basic/Graph.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "synthetic_graph.h"
+#include "test_common.h"
+#include "test_graphs.h"
+#include "test_topologies.h"
+#include "vulnerability.h"
+
+namespace {
+
+// The graph by node and edge index, with whatever has been taken out marked
+// gone, answered by a breadth-first search per question.
+struct index_model {
+    std::vector<char> node_gone;
+    std::vector<char> edge_gone;
+    std::vector<std::pair<int, int>> endpoints;
+
+    explicit index_model(const ogdf::Graph& graph)
+        : node_gone(graph.maxNodeIndex() + 1, 1),
+          edge_gone(graph.maxEdgeIndex() + 1, 1),
+          endpoints(graph.maxEdgeIndex() + 1, {0, 0}) {
+        for (ogdf::node v : graph.nodes) {
+            node_gone[v->index()] = 0;
+        }
+
+        for (ogdf::edge e : graph.edges) {
+            edge_gone[e->index()] = 0;
+            endpoints[e->index()] = {e->source()->index(), e->target()->index()};
+        }
+    }
+
+    removal_effect effect() const {
+        std::vector<std::vector<int>> adjacent(node_gone.size());
+
+        for (std::size_t e = 0; e < endpoints.size(); e++) {
+            const auto [u, v] = endpoints[e];
+
+            if (!edge_gone[e] && !node_gone[u] && !node_gone[v]) {
+                adjacent[u].push_back(v);
+                adjacent[v].push_back(u);
+            }
+        }
+
+        removal_effect result{.components = 0, .largest_component = 0};
+        std::vector<char> seen(node_gone.size(), 0);
+        std::vector<int> queue;
+
+        for (std::size_t root = 0; root < node_gone.size(); root++) {
+            if (node_gone[root] || seen[root]) {
+                continue;
+            }
+
+            queue.assign(1, static_cast<int>(root));
+            seen[root] = 1;
+
+            for (std::size_t head = 0; head < queue.size(); head++) {
+                for (const int u : adjacent[queue[head]]) {
+                    if (!seen[u]) {
+                        seen[u] = 1;
+                        queue.push_back(u);
+                    }
+                }
+            }
+
+            result.components++;
+            result.largest_component =
+                std::max(result.largest_component, static_cast<int>(queue.size()));
+        }
+
+        return result;
+    }
+
+    void remove(const removal& r) {
+        (r.type == removal::kind::country ? node_gone : edge_gone)[r.index] = 1;
+    }
+};
+
+// A synthetic graph with a few countries and borders deleted up front, so the
+// reports have holes to skip.
+void graph_with_holes(synthetic::topology t, ogdf::Graph& graph) {
+    const auto nodes = test::to_ogdf(synthetic::generate(t, 300), graph);
+
+    for (std::size_t i = 0; i < nodes.size(); i += 37) {
+        graph.delNode(nodes[i]);
+    }
+
+    std::vector<ogdf::edge> edges;
+
+    for (ogdf::edge e : graph.edges) {
+        edges.push_back(e);
+    }
+
+    for (std::size_t i = 0; i < edges.size(); i += 23) {
+        graph.delEdge(edges[i]);
+    }
+}
+
+void single_removals(synthetic::topology t) {
+    ogdf::Graph graph;
+    graph_with_holes(t, graph);
+
+    const auto report = analyse_vulnerability(graph);
+    index_model model(graph);
+
+    test::expect(report.intact == model.effect(), "the intact graph to be measured");
+
+    std::vector<int> articulation;
+    std::vector<int> bridges;
+
+    for (std::size_t v = 0; v < model.node_gone.size(); v++) {
+        if (model.node_gone[v]) {
+            test::expect(report.country_removal[v] == report.intact,
+                         "a deleted country to hold the intact effect");
+            continue;
+        }
+
+        model.node_gone[v] = 1;
+        const auto expected = model.effect();
+        model.node_gone[v] = 0;
+
+        test::expect(report.country_removal[v] == expected,
+                     "the effect of removing country " + std::to_string(v));
+
+        if (expected.components > report.intact.components) {
+            articulation.push_back(static_cast<int>(v));
+        }
+    }
+
+    for (std::size_t e = 0; e < model.edge_gone.size(); e++) {
+        if (model.edge_gone[e]) {
+            test::expect(report.border_removal[e] == report.intact,
+                         "a deleted border to hold the intact effect");
+            continue;
+        }
+
+        model.edge_gone[e] = 1;
+        const auto expected = model.effect();
+        model.edge_gone[e] = 0;
+
+        test::expect(report.border_removal[e] == expected,
+                     "the effect of removing border " + std::to_string(e));
+
+        if (expected.components > report.intact.components) {
+            bridges.push_back(static_cast<int>(e));
+        }
+    }
+
+    test::expect(report.articulation_countries == articulation,
+                 "exactly the countries whose removal splits their component");
+    test::expect(report.bridge_borders == bridges,
+                 "exactly the borders whose removal splits their component");
+}
+
+// Every country and border in random order, with repeats and borders of
+// countries that are already gone mixed in.
+void sequence(synthetic::topology t) {
+    ogdf::Graph graph;
+    graph_with_holes(t, graph);
+
+    std::vector<removal> removals;
+
+    for (ogdf::node v : graph.nodes) {
+        removals.push_back({.type = removal::kind::country, .index = v->index()});
+    }
+
+    for (ogdf::edge e : graph.edges) {
+        removals.push_back({.type = removal::kind::border, .index = e->index()});
+    }
+
+    std::mt19937 rng(7);
+    std::shuffle(removals.begin(), removals.end(), rng);
+
+    for (std::size_t i = 0; i < removals.size(); i += 11) {
+        removals.push_back(removals[i]);
+    }
+
+    std::shuffle(removals.begin(), removals.end(), rng);
+
+    const auto effects = removal_sequence(graph, removals);
+
+    test::expect(effects.has_value(), "a sequence of existing countries and borders");
+
+    if (!effects) {
+        return;
+    }
+
+    test::expect(effects->size() == removals.size(), "one effect per removal");
+
+    const auto report = analyse_vulnerability(graph);
+    const removal& first = removals.front();
+
+    test::expect(effects->front() == (first.type == removal::kind::country
+                                          ? report.country_removal
+                                          : report.border_removal)[first.index],
+                 "the first removal to match the single-removal analysis");
+
+    index_model model(graph);
+
+    for (std::size_t i = 0; i < removals.size(); i++) {
+        model.remove(removals[i]);
+
+        test::expect((*effects)[i] == model.effect(),
+                     "the effect after removal " + std::to_string(i));
+    }
+
+    test::expect(effects->back().components == 0, "nothing to be left at the end");
+}
+
+void errors() {
+    ogdf::Graph graph;
+    const auto nodes = test::path(4, graph);
+    const int deleted_border = graph.searchEdge(nodes[0], nodes[1])->index();
+    const int deleted_country = nodes[3]->index();
+
+    graph.delEdge(graph.searchEdge(nodes[0], nodes[1]));
+    graph.delNode(nodes[3]);
+
+    const auto failure = [&](std::vector<removal> removals) {
+        const auto effects = removal_sequence(graph, removals);
+
+        test::expect(!effects.has_value(), "an unknown removal to be rejected");
+
+        return effects ? removal_error{} : effects.error();
+    };
+
+    const removal kept{.type = removal::kind::country, .index = nodes[1]->index()};
+
+    const auto country =
+        failure({kept, {.type = removal::kind::country, .index = deleted_country}});
+
+    test::expect(country.error_code == removal_error::code::unknown_country &&
+                     country.removal_index == 1,
+                 "a deleted country to be unknown at its position");
+
+    const auto border = failure({{.type = removal::kind::border, .index = deleted_border}, kept});
+
+    test::expect(border.error_code == removal_error::code::unknown_border &&
+                     border.removal_index == 0,
+                 "a deleted border to be unknown at its position");
+
+    test::expect(failure({{.type = removal::kind::country, .index = -1}}).error_code ==
+                     removal_error::code::unknown_country,
+                 "a negative index to be unknown");
+    test::expect(failure({{.type = removal::kind::border, .index = 100}}).error_code ==
+                     removal_error::code::unknown_border,
+                 "an index past the last border to be unknown");
+
+    const auto empty = removal_sequence(graph, {});
+
+    test::expect(empty.has_value() && empty->empty(), "an empty sequence to have no effects");
+}
+
+}  // namespace
+
+int main() {
+    test::run_per_topology("single_removals", single_removals);
+    test::run_per_topology("sequence", sequence);
+
+    test::run("errors", errors);
+
+    return test::result();
+}